@@ -104,16 +104,14 @@ int main(int argc, char **argv) {
   // METRICS
   cout << "===> Analysis: " << endl;
   // Create a hierarchy tree for every qid
-  map<int, Tree> trees;
-  for (const int &i : catQids) {
-    trees[i] = Tree(hierarchiesMap[i]);
-  }
+  const HierarchyRegistry registry(move(hierarchiesMap), catQids);
 
   // GCP
   try {
     // 	1. Precalculate NCP for every qid value included in every cluster
     vector<long double> cncps =
-        calculateNCPS(clusters, weights, allQids, numMetricsQids, trees);
+        calculateNCPS(clusters, weights, allQids, numMetricsQids,
+                      registry.getTrees());
     // 	2. Calculate GCP
     calculateGCP(clusters, dataset.size(), allQids, cncps);
   } catch (const char *e) {
@@ -131,8 +129,8 @@ int main(int argc, char **argv) {
 
   // GenILoss
   try {
-    calculateGenILoss(transpose(result), trees, allQids, catMetricsQids,
-                      numMetricsQids, dataset.size());
+    calculateGenILoss(transpose(result), registry.getTrees(), allQids,
+                      catMetricsQids, numMetricsQids, dataset.size());
   } catch (const char *e) {
     cout << e << endl;
     return -1;
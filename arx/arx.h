@@ -3,6 +3,7 @@
 
 #include "../utilities/analysis.h"
 #include "../utilities/hierarchy.h"
+#include "../utilities/hierarchyRegistry.h"
 #include "../utilities/input.h"
 #include "../utilities/frequencies.h"
 #include "../utilities/metrics.h"
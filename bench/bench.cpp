@@ -0,0 +1,350 @@
+/*! \file bench.cpp
+    \brief Fichero que contiene el banco de pruebas de rendimiento. Ejecuta
+           cada algoritmo de forma no interactiva sobre los conjuntos de datos
+           incluidos en el repositorio y muestra, en formato CSV, el tiempo
+           total, el tiempo de cada fase, el pico de memoria residente y el
+           número de registros procesados por segundo.
+*/
+
+#include "bench.h"
+
+/*! Crea una ejecución en modo batch (Mondrian, Incognito y Datafly).
+  \param algorithm nombre del algoritmo.
+  \param dataset nombre del conjunto de datos.
+  \param data directorio del conjunto de datos.
+  \param keys parámetros del fichero de configuración.
+  \param setting línea "K L T" de la ejecución.
+  \return ejecución.
+*/
+static BenchCase batchCase(const string &algorithm, const string &dataset,
+                           const fs::path &data, const string &keys,
+                           const string &setting) {
+  BenchCase bench;
+  bench.algorithm = algorithm;
+  bench.dataset = dataset;
+  bench.setting = setting;
+  bench.data = data;
+  bench.args = {data.string(), "--batch", "bench.cfg"};
+  bench.config = keys + "output = sweep.csv\n" + setting + "\n";
+  return bench;
+}
+
+/*! Crea una ejecución interactiva, cuyas respuestas se envían por la
+    entrada estándar (K-Member y K-Means).
+  \param algorithm nombre del algoritmo.
+  \param dataset nombre del conjunto de datos.
+  \param data directorio o fichero del conjunto de datos.
+  \param args argumentos del programa.
+  \param input respuestas a las preguntas del programa.
+  \param setting descripción de los parámetros utilizados.
+  \return ejecución.
+*/
+static BenchCase interactiveCase(const string &algorithm,
+                                 const string &dataset, const fs::path &data,
+                                 const vector<string> &args,
+                                 const string &input, const string &setting) {
+  BenchCase bench;
+  bench.algorithm = algorithm;
+  bench.dataset = dataset;
+  bench.setting = setting;
+  bench.data = data;
+  bench.args = args;
+  bench.input = input;
+  return bench;
+}
+
+/*! Construye la lista de ejecuciones del banco de pruebas.
+  \param root directorio raíz del repositorio.
+  \return ejecuciones.
+*/
+vector<BenchCase> benchSuite(const fs::path &root) {
+  vector<BenchCase> suite;
+  const fs::path adult = root / "datasets/adult";
+  const fs::path bank = root / "datasets/bank";
+
+  // Mondrian
+  const string adultKeys = "qids = age,education,occupation\n"
+                           "confatts = salary\n";
+  const string bankKeys = "qids = age,education,job\n";
+  suite.emplace_back(batchCase("mondrian", "adult/age_numerical",
+                               adult / "age_numerical", adultKeys,
+                               "10 -1 -1"));
+  suite.emplace_back(batchCase("mondrian", "adult/age_numerical",
+                               adult / "age_numerical", adultKeys,
+                               "10 2 -1"));
+  suite.emplace_back(batchCase("mondrian", "adult/age_categorical",
+                               adult / "age_categorical", adultKeys,
+                               "10 -1 -1"));
+  suite.emplace_back(batchCase("mondrian", "bank/age_numerical",
+                               bank / "age_numerical", bankKeys, "10 -1 -1"));
+  suite.emplace_back(batchCase("mondrian", "bank/age_categorical",
+                               bank / "age_categorical", bankKeys,
+                               "10 -1 -1"));
+
+  // Incognito
+  suite.emplace_back(batchCase("incognito", "adult/age_categorical",
+                               adult / "age_categorical",
+                               "qids = age,education,sex\n", "10 -1 -1"));
+  suite.emplace_back(batchCase("incognito", "bank/age_categorical",
+                               bank / "age_categorical",
+                               "qids = age,education,marital-status\n",
+                               "10 -1 -1"));
+
+  // Datafly
+  suite.emplace_back(batchCase("datafly", "adult/age_categorical",
+                               adult / "age_categorical",
+                               "qids = age,education,sex,race\nsupp = 1\n",
+                               "10 -1 -1"));
+  suite.emplace_back(batchCase("datafly", "bank/age_categorical",
+                               bank / "age_categorical",
+                               "qids = age,education,job\nsupp = 1\n",
+                               "5 -1 -1"));
+
+  // K-Member
+  for (const string name :
+       {"adult-800-age-categorical", "adult-800-age-numerical",
+        "bank-800-age-categorical", "bank-800-age-numerical"}) {
+    const fs::path data = root / "kmember/datasets" / name;
+    const string qids = name.rfind("adult", 0) == 0
+                            ? "3\nage\neducation\nsex\n"
+                            : "3\nage\neducation\njob\n";
+    suite.emplace_back(interactiveCase("kmember", name, data, {data.string()},
+                                       qids + "n\ny\n20\nn\nn\nn\n",
+                                       "20 -1 -1"));
+  }
+
+  // K-Means
+  for (const string size : {"5K", "10K", "25K", "50K"}) {
+    const fs::path data =
+        root / "kmeans/datasets/6-attributes" / ("kmeans-" + size + ".csv");
+    suite.emplace_back(interactiveCase("kmeans", "kmeans-" + size, data,
+                                       {data.string(), "10"},
+                                       "2\nweight\nph\n5\nn\n", "k=10"));
+  }
+
+  return suite;
+}
+
+/*! Cuenta el número de registros de un conjunto de datos (sin cabecera).
+  \param data directorio o fichero del conjunto de datos.
+  \return número de registros.
+*/
+static size_t countRows(const fs::path &data) {
+  fs::path file = data;
+  if (fs::is_directory(data)) {
+    for (const auto &entry : fs::directory_iterator(data)) {
+      if (entry.is_regular_file() && entry.path().extension() == ".csv") {
+        file = entry.path();
+        break;
+      }
+    }
+  }
+
+  ifstream fp(file);
+  size_t rows = 0;
+  string line;
+  while (getline(fp, line)) {
+    if (!line.empty())
+      rows++;
+  }
+  return rows == 0 ? 0 : rows - 1;
+}
+
+/*! Divide una línea del fichero de métricas del modo batch.
+  \param line línea.
+  \return valores de la línea.
+*/
+static vector<string> splitRow(const string &line) {
+  vector<string> values;
+  stringstream stream(line);
+  string value;
+  while (getline(stream, value, ';'))
+    values.emplace_back(value);
+  return values;
+}
+
+/*! Lee los tiempos de cada fase de la última fila del fichero de métricas
+    generado en modo batch.
+  \param sweep fichero de métricas.
+  \param result resultado de la ejecución.
+*/
+static void readPhases(const fs::path &sweep, BenchResult &result) {
+  ifstream fp(sweep);
+  string line, last;
+  while (getline(fp, line)) {
+    if (!line.empty())
+      last = line;
+  }
+
+  // algorithm;K;L;T;clusters;load_s;run_s;metrics_s;...
+  const vector<string> values = splitRow(last);
+  if (values.size() < 8 || values[0] == "algorithm")
+    return;
+  result.loadSeconds = stod(values[5]);
+  result.runSeconds = stod(values[6]);
+  result.metricsSeconds = stod(values[7]);
+}
+
+/*! Lee el tiempo de ejecución del algoritmo mostrado por pantalla por las
+    ejecuciones interactivas ("Execution Time: N seconds|microseconds").
+  \param log salida del programa.
+  \param result resultado de la ejecución.
+*/
+static void readExecutionTime(const fs::path &log, BenchResult &result) {
+  ifstream fp(log);
+  string line;
+  while (getline(fp, line)) {
+    const size_t pos = line.find("Execution Time: ");
+    if (pos == string::npos)
+      continue;
+
+    stringstream stream(line.substr(pos + 16));
+    double value;
+    string unit;
+    if (!(stream >> value >> unit))
+      continue;
+    result.runSeconds = unit == "microseconds" ? value / 1e6 : value;
+  }
+}
+
+/*! Ejecuta un algoritmo en un directorio de trabajo, midiendo el tiempo
+    total y el pico de memoria residente del proceso.
+  \param bench ejecución.
+  \param root directorio raíz del repositorio.
+  \param workDir directorio de trabajo.
+  \return resultado de la ejecución.
+*/
+BenchResult runCase(const BenchCase &bench, const fs::path &root,
+                    const fs::path &workDir) {
+  BenchResult result;
+  result.rows = countRows(bench.data);
+
+  fs::remove_all(workDir);
+  fs::create_directories(workDir);
+  if (!bench.config.empty()) {
+    ofstream fp(workDir / "bench.cfg");
+    fp << bench.config;
+  }
+
+  const string binary =
+      (root / bench.algorithm / (bench.algorithm + ".out")).string();
+  const string log = (workDir / "bench.log").string();
+
+  int fds[2];
+  if (pipe(fds) != 0)
+    throw "Error creating pipe";
+
+  const auto start = chrono::steady_clock::now();
+  const pid_t pid = fork();
+  if (pid < 0)
+    throw "Error creating process";
+
+  if (pid == 0) {
+    // Proceso hijo: entrada estándar desde la tubería, salida al log
+    close(fds[1]);
+    dup2(fds[0], STDIN_FILENO);
+    close(fds[0]);
+    const int out = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    dup2(out, STDOUT_FILENO);
+    dup2(out, STDERR_FILENO);
+    close(out);
+    if (chdir(workDir.c_str()) != 0)
+      _exit(127);
+
+    vector<char *> argv;
+    argv.emplace_back(const_cast<char *>(binary.c_str()));
+    for (const string &arg : bench.args)
+      argv.emplace_back(const_cast<char *>(arg.c_str()));
+    argv.emplace_back(nullptr);
+    execv(binary.c_str(), argv.data());
+    _exit(127);
+  }
+
+  close(fds[0]);
+  size_t written = 0;
+  while (written < bench.input.size()) {
+    const ssize_t n = write(fds[1], bench.input.data() + written,
+                            bench.input.size() - written);
+    if (n <= 0)
+      break;
+    written += n;
+  }
+  close(fds[1]);
+
+  int status;
+  struct rusage usage;
+  wait4(pid, &status, 0, &usage);
+  result.wallSeconds =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  result.peakRssKb = usage.ru_maxrss;
+  if (WIFEXITED(status))
+    result.status = WEXITSTATUS(status);
+  else if (WIFSIGNALED(status))
+    result.status = 128 + WTERMSIG(status);
+
+  if (!bench.config.empty())
+    readPhases(workDir / "sweep.csv", result);
+  else
+    readExecutionTime(log, result);
+
+  fs::remove_all(workDir);
+  return result;
+}
+
+/*! Formatea un tiempo, dejando la celda vacía si no está disponible.
+  \param seconds tiempo en segundos.
+  \return valor formateado.
+*/
+static string seconds(const double seconds) {
+  if (seconds < 0)
+    return "";
+  stringstream stream;
+  stream << fixed << setprecision(6) << seconds;
+  return stream.str();
+}
+
+int main(int argc, char **argv) {
+  if (argc > 3) {
+    cout << "\nInvalid arguments.\n"
+            "Use ./bench.out [repository directory] [algorithm]\n"
+         << endl;
+    return -1;
+  }
+
+  const fs::path root = fs::absolute(argc > 1 ? argv[1] : "..");
+  const string filter = argc > 2 ? argv[2] : "";
+  const fs::path workDir = root / "bench/work";
+
+  cout << "algorithm;dataset;setting;rows;status;wall_s;load_s;run_s;"
+          "metrics_s;peak_rss_kb;rows_per_s"
+       << endl;
+
+  int failures = 0;
+  for (const BenchCase &bench : benchSuite(root)) {
+    if (!filter.empty() && bench.algorithm != filter)
+      continue;
+
+    cerr << "* " << bench.algorithm << " " << bench.dataset << " ("
+         << bench.setting << ")" << endl;
+    BenchResult result;
+    try {
+      result = runCase(bench, root, workDir);
+    } catch (const char *e) {
+      cerr << e << endl;
+      return -1;
+    }
+    if (result.status != 0)
+      failures++;
+
+    const double throughput =
+        result.wallSeconds > 0 ? result.rows / result.wallSeconds : 0;
+    cout << bench.algorithm << ";" << bench.dataset << ";" << bench.setting
+         << ";" << result.rows << ";" << result.status << ";"
+         << seconds(result.wallSeconds) << ";" << seconds(result.loadSeconds)
+         << ";" << seconds(result.runSeconds) << ";"
+         << seconds(result.metricsSeconds) << ";" << result.peakRssKb << ";"
+         << fixed << setprecision(1) << throughput << endl;
+  }
+
+  return failures == 0 ? 0 : 1;
+}
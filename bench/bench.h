@@ -0,0 +1,57 @@
+/*! \file bench.h
+    \brief Fichero de cabecera del archivo bench.cpp.
+*/
+
+#ifndef _BENCH_H
+#define _BENCH_H
+
+#include <chrono>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace std;
+
+/*! Estructura BenchCase. Ejecución de un algoritmo sobre un conjunto de
+    datos. Si config no está vacío, el algoritmo se ejecuta en modo batch
+    con dicha configuración; en otro caso, input se envía por la entrada
+    estándar.
+*/
+struct BenchCase {
+  string algorithm;
+  string dataset;
+  string setting;
+  vector<string> args;
+  string input;
+  string config;
+  fs::path data;
+};
+
+/*! Estructura BenchResult. Tiempos y memoria medidos en una ejecución
+    (-1 en las fases no disponibles).
+*/
+struct BenchResult {
+  int status = -1;
+  size_t rows = 0;
+  double wallSeconds = 0;
+  double loadSeconds = -1;
+  double runSeconds = -1;
+  double metricsSeconds = -1;
+  long peakRssKb = 0;
+};
+
+vector<BenchCase> benchSuite(const fs::path &root);
+BenchResult runCase(const BenchCase &bench, const fs::path &root,
+                    const fs::path &workDir);
+int main(int argc, char **argv);
+
+#endif
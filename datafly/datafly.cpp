@@ -1,10 +1,93 @@
 #include "datafly.h"
 
+/*! Anonimiza el conjunto de datos con unos parámetros dados, escribe el
+    conjunto de datos anonimizado y calcula las métricas.
+  \param dir directorio del conjunto de datos.
+  \param dataset conjunto de datos codificado.
+  \param registry registro con las jerarquías y los árboles de los qids.
+  \param qids índices de los atributos qids.
+  \param confAtts índices de los atributos sensibles.
+  \param suppThreshold umbral de supresión.
+  \param weights pesos de cada qid.
+  \param numMetricsQids qids considerados numéricos en las métricas.
+  \param catMetricsQids qids considerados categóricos en las métricas.
+  \param setting parámetros de los modelos de privacidad.
+  \return resultado y métricas de la ejecución (sin clases de equivalencia
+          si no se ha podido anonimizar el conjunto de datos).
+*/
+SweepResult anonymize(const string &dir, const Table &dataset,
+                      const HierarchyRegistry &registry,
+                      const vector<int> &qids,
+                      const vector<int> &confAtts,
+                      const long double suppThreshold,
+                      const vector<double> &weights,
+                      const vector<int> &numMetricsQids,
+                      const vector<int> &catMetricsQids,
+                      const SweepSetting &setting) {
+  SweepResult sweepResult;
+  sweepResult.setting = setting;
+  const int K = setting.K;
+
+  // Calcular el tiempo de ejecución
+  auto start = chrono::high_resolution_clock::now();
+  // *********************************
+  // Algoritmo principal
+  auto resTuple =
+      datafly(dataset, registry.getTrees(), qids, confAtts, suppThreshold, K);
+  Table anonymized = get<0>(resTuple);
+  vector<vector<vector<string>>> clusters = get<1>(resTuple);
+  if (anonymized.numRows() == 0 || clusters.size() == 0)
+    return sweepResult;
+  // *********************************
+  auto stop = chrono::high_resolution_clock::now();
+  auto duration = chrono::duration_cast<chrono::seconds>(stop - start);
+  cout << endl << "===> Datafly Execution Time: ";
+  cout << duration.count() << " seconds" << endl;
+  sweepResult.runSeconds = chrono::duration<double>(stop - start).count();
+
+  cout << "===> Number of clusters: ";
+  cout << clusters.size() << endl;
+  sweepResult.clusters = clusters.size();
+
+  // Escribir conjunto de datos anonimizado
+  writeAnonymizedTable(dir, anonymized, K, -1, -1);
+
+  // Métricas
+  const auto metricsStart = chrono::steady_clock::now();
+  cout << "===> Analysis: " << endl;
+
+  // GCP
+  // 1. Precalcular NCP para cada atributo qid
+  vector<long double> cncps =
+      calculateNCPS(clusters, weights, qids, numMetricsQids,
+                    registry.getTrees());
+
+  // 2. Calcular GCP
+  sweepResult.gcp = calculateGCP(clusters, dataset.numRows(), qids, cncps);
+
+  // DM
+  sweepResult.dm = calculateDM(clusters, dataset.numRows(), K);
+
+  // CAvg
+  sweepResult.cavg = calculateCAVG(clusters, dataset.numRows(), K);
+
+  // GenILoss
+  sweepResult.genILoss =
+      calculateGenILoss(transpose(anonymized.decode()), registry.getTrees(),
+                        qids, catMetricsQids, numMetricsQids,
+                        dataset.numRows());
+  sweepResult.metricsSeconds = elapsedSeconds(metricsStart);
+
+  return sweepResult;
+}
+
 int main(int argc, char **argv) {
+  const bool batch = isBatchMode(argc, argv);
 
-  if (argc != 2) {
+  if (argc != 2 && !batch) {
     cout << "\nInvalid arguments.\n"
-            "Use ./datafly.out [data directory]\n\n"
+            "Use ./datafly.out [data directory] "
+            "[--batch configuration file]\n\n"
             "* Make sure your data directory meets the following structure:\n"
             "  (check dataset folder for an example)\n\n"
             " |-- [data directory]\n"
@@ -18,18 +101,32 @@ int main(int argc, char **argv) {
     return -1;
   }
 
-  // Leer parámetros
-  const int nqids = readNumberOfQids();
-  // Leer nombres de qids
-  vector<string> qidNames = readQidNames(nqids);
+  // Leer parámetros, de la entrada estándar o del fichero de configuración
+  SweepConfig config;
+  vector<string> qidNames;
   vector<string> confAttNames;
+  try {
+    if (batch) {
+      // Datafly no utiliza atributos sensibles
+      config = readSweepConfig(argv[3]);
+      qidNames = config.qidNames;
+    } else {
+      const int nqids = readNumberOfQids();
+      // Leer nombres de qids
+      qidNames = readQidNames(nqids);
+    }
+  } catch (const char *e) {
+    cout << e << endl;
+    return -1;
+  }
 
   // Leer el directorio que contiene el conjunto de datos y las jerarquias
   vector<string> headers;
   vector<int> qids, confAtts;
-  vector<vector<string>> qidsDataset, dataset;
+  Table dataset;
   map<int, vector<vector<string>>> hierarchiesMap;
 
+  const auto loadStart = chrono::steady_clock::now();
   try {
     hierarchiesMap =
         readDirectory(fs::path(argv[1]), dataset, headers, qidNames,
@@ -62,79 +159,77 @@ int main(int argc, char **argv) {
     return -1;
   }
 
-  // Leer parámetros vinculados a los modelos de privacidad
-  const int K = readParameter("k-anonymity", "K", dataset.size());
-  if (K == -1) {
-    cout << "Error, Datafly needs parameter K." << endl;
-    return -1;
-  }
-  long double suppThreshold = readSuppThreshold();
+  // Convertir árboles jerárquicos en un mapa de datos
+  const HierarchyRegistry registry(move(hierarchiesMap), qids);
+  const double loadSeconds = elapsedSeconds(loadStart);
 
-  // Leer pesos asignados a cada qid
-  vector<double> weights = readWeights(nqids, qidNames);
-  // Leer tipos de qids (importante considerar los atributos numéricos como tales)
+  long double suppThreshold;
+  vector<double> weights;
   vector<int> numMetricsQids, catMetricsQids;
-  tuple<vector<int>, vector<int>> metricsQids =
-      readMetricsQids({}, qids, headers);
+  tuple<vector<int>, vector<int>> metricsQids;
+  if (batch) {
+    try {
+      for (const SweepSetting &setting : config.settings) {
+        checkSweepSetting(setting, dataset.numRows(), confAttNames.size());
+        if (setting.K == -1)
+          throw "Error, Datafly needs parameter K.";
+      }
+      if (config.suppThreshold < 0.0 || config.suppThreshold > 100.0)
+        throw "Error, Datafly needs a suppression threshold (supp) "
+              "between 0 and 100.";
+      suppThreshold = config.suppThreshold;
+      weights = sweepWeights(config);
+      metricsQids = sweepMetricsQids(config, {}, qids, headers);
+    } catch (const char *e) {
+      cout << e << endl;
+      return -1;
+    }
+  } else {
+    // Leer parámetros vinculados a los modelos de privacidad
+    SweepSetting setting;
+    setting.K = readParameter("k-anonymity", "K", dataset.numRows());
+    if (setting.K == -1) {
+      cout << "Error, Datafly needs parameter K." << endl;
+      return -1;
+    }
+    config.settings.emplace_back(setting);
+    suppThreshold = readSuppThreshold();
+
+    // Leer pesos asignados a cada qid
+    weights = readWeights(qidNames.size(), qidNames);
+    // Leer tipos de qids (importante considerar los atributos numéricos como
+    // tales)
+    metricsQids = readMetricsQids({}, qids, headers);
+  }
   numMetricsQids = get<0>(metricsQids);
   catMetricsQids = get<1>(metricsQids);
 
-  // Calcular el tiempo de ejecución
-  auto start = chrono::high_resolution_clock::now();
-  // *********************************
-  // Algoritmo principal
-  auto resTuple =
-      datafly(dataset, hierarchiesMap, qids, confAtts, suppThreshold, K);
-  vector<vector<string>> result = get<0>(resTuple);
-  vector<vector<vector<string>>> clusters = get<1>(resTuple);
-  if (result.size() == 0 || clusters.size() == 0)
-    return 1;
-  // *********************************
-  auto stop = chrono::high_resolution_clock::now();
-  auto duration = chrono::duration_cast<chrono::seconds>(stop - start);
-  cout << endl << "===> Datafly Execution Time: ";
-  cout << duration.count() << " seconds" << endl;
-
-  cout << "===> Number of clusters: ";
-  cout << clusters.size() << endl;
-
-  // Escribir conjunto de datos anonimizado
-  writeAnonymizedTable(fs::path(argv[1]), headers, result, K, -1, -1);
-
-  // Métricas
-  cout << "===> Analysis: " << endl;
-  // Convertir árboles jerárquicos en un mapa de datos
-  map<int, Tree> trees;
-  for (const int &i : qids) {
-    trees[i] = Tree(hierarchiesMap[i]);
-  }
-
-  // GCP
+  ofstream sweepFile;
+  string sweepName;
   try {
-    // 1. Precalcular NCP para cada atributo qid
-    vector<long double> cncps =
-        calculateNCPS(clusters, weights, qids, numMetricsQids, trees);
+    if (batch) {
+      sweepName = sweepOutputName(config, argv[1], "datafly");
+      sweepFile.open(sweepName);
+      writeSweepHeader(sweepFile);
+    }
 
-    // 2. Calcular GCP
-    calculateGCP(clusters, dataset.size(), qids, cncps);
+    for (const SweepSetting &setting : config.settings) {
+      SweepResult result = anonymize(
+          argv[1], dataset, registry, qids, confAtts,
+          suppThreshold, weights, numMetricsQids, catMetricsQids, setting);
+      if (!batch && result.clusters == 0)
+        return 1;
+      if (batch)
+        writeSweepRow(sweepFile, "datafly", loadSeconds, result);
+    }
   } catch (const char *e) {
     cout << e << endl;
     return -1;
   }
 
-  // DM
-  calculateDM(clusters, dataset.size(), K);
-
-  // CAvg
-  calculateCAVG(clusters, dataset.size(), K);
-
-  // GenILoss
-  try {
-    calculateGenILoss(transpose(result), trees, qids, catMetricsQids,
-                      numMetricsQids, dataset.size());
-  } catch (const char *e) {
-    cout << e << endl;
-    return -1;
+  if (batch) {
+    cout << endl << "===> Sweep metrics written to file: " << endl;
+    cout << "\t* " + sweepName << endl;
   }
 
   return 0;
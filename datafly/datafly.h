@@ -8,8 +8,10 @@
 #include "../utilities/analysis.h"
 #include "../utilities/frequencies.h"
 #include "../utilities/hierarchy.h"
+#include "../utilities/hierarchyRegistry.h"
 #include "../utilities/input.h"
 #include "../utilities/metrics.h"
+#include "../utilities/sweep.h"
 #include "../utilities/tree.h"
 #include "../utilities/writeData.h"
 #include "evaluate.h"
@@ -19,6 +21,15 @@
 #include <ostream>
 #include <vector>
 
+SweepResult anonymize(const string &dir, const Table &dataset,
+                      const HierarchyRegistry &registry,
+                      const vector<int> &qids,
+                      const vector<int> &confAtts,
+                      const long double suppThreshold,
+                      const vector<double> &weights,
+                      const vector<int> &numMetricsQids,
+                      const vector<int> &catMetricsQids,
+                      const SweepSetting &setting);
 int main(int argc, char **argv);
 
 #endif
@@ -7,7 +7,7 @@
 
 /*! Determina si el conjunto de datos se encuentra lista para la fase de
     supresión de registros.
-  \param dataset conjunto de datos.
+  \param table conjunto de datos codificado.
   \param qids índices de los atributos qids.
   \param tableSize cardinalidad de un conjunto de datos.
   \param K parámetro del modelo de privacidad k-anonymity.
@@ -15,12 +15,12 @@
                        máximo de datos a suprimir.
   \return 1 si la tabla se encuentra lista para la supresión, 0 si no es así.
 */
-bool readyForSuppression(vector<vector<string>> dataset, vector<int> qids,
+bool readyForSuppression(const Table &table, vector<int> qids,
                          const int tableSize, const int K,
                          const long double suppThreshold) {
 
   int count = 0;
-  for (const auto &freq : calculateFreqs(dataset)) {
+  for (const auto &freq : calculateFreqs(table, qids)) {
     if (freq < K)
       count += freq;
   }
@@ -29,9 +29,11 @@ bool readyForSuppression(vector<vector<string>> dataset, vector<int> qids,
   return (count <= (suppThreshold * tableSize) / 100);
 }
 
-/*! Bucle principal del algoritmo Datafly.
-  \param dataset conjunto de datos.
-  \param hierarchies conjunto de jerarquías (una por cada atributo).
+/*! Bucle principal del algoritmo Datafly. Trabaja directamente sobre la
+    tabla codificada: generalizar un qid consiste en recodificar el
+    diccionario de su columna.
+  \param table conjunto de datos codificado.
+  \param trees árboles de jerarquía de los qids.
   \param qids índices de los atributos qids.
   \param confAtts conjunto de atributos sensibles o SAs.
   \param suppThreshold parámetro relacionado con el porcentaje
@@ -40,60 +42,36 @@ bool readyForSuppression(vector<vector<string>> dataset, vector<int> qids,
   \return tupla conteniendo la tabla anonimizada y las distintas clases
           de equivalencia correspondientes.
 */
-tuple<vector<vector<string>>, vector<vector<vector<string>>>>
-datafly(vector<vector<string>> dataset,
-        map<int, vector<vector<string>>> hierarchies, vector<int> qids,
-        vector<int> confAtts, const long double suppThreshold, const int K) {
-  vector<vector<string>> qidsDataset, result;
+tuple<Table, vector<vector<vector<string>>>>
+datafly(Table table, const map<int, Tree> &trees,
+        vector<int> qids, vector<int> confAtts,
+        const long double suppThreshold, const int K) {
   vector<vector<vector<string>>> clusters;
-
-  // Obtener subconjunto de datos conteniendo únicamente qids
-	for (size_t i=0; i < dataset.size(); i++) {
-		vector<string> aux;
-		for (const int& idx : qids) {
-			aux.emplace_back(dataset[i][idx]);
-		}
-		qidsDataset.emplace_back(aux);
-	}
-
-  // 1. Crear un árbol jerárquico para cada qid
-  vector<Tree> trees;
-  for (const int &val : qids) {
-    trees.emplace_back(Tree(hierarchies[val]));
-  }
+  const int tableSize = table.numRows();
 
   int idx;
   // 2&3. Calcular frecuencias y comprobar si la k-anonimidad se cumple
-	while (!isKAnonSatisfied(qidsDataset, K)) {
+  while (!isKAnonSatisfied(table, qids, K)) {
     // Comprobar si la tabla esta lista para la fase de supresión
-    if (readyForSuppression(qidsDataset, qids, dataset.size(), K,
-                            suppThreshold)) {
+    if (readyForSuppression(table, qids, tableSize, K, suppThreshold)) {
       // 4. Suprimir registros que no sean k-anonimos (< K veces)
-      supressRecords(qidsDataset, qids, K);
+      supressRecords(table, qids, K);
       break;
     }
 
     // 5. Encontrar el qid con el mayor número de valores únicos
-    idx = findMostDistinctQid(qidsDataset);
+    idx = findMostDistinctQid(table, qids);
 
     // 6. Generalizar el atributo qid
     try {
-      generalizeQid(qidsDataset, idx, trees[idx]);
+      generalizeQid(table, qids[idx], trees.at(qids[idx]));
     } catch (const char *e) {
       cout << e << endl;
-      return make_tuple(qidsDataset, clusters);
+      return make_tuple(table, clusters);
     }
   }
 
-  // Actualizar conjunto de datos original con los valores generalizados
-  result = dataset;
-	for (size_t i=0; i < dataset.size(); i++) {
-		for (size_t j=0; j < qids.size(); j++) {
-			result[i][qids[j]] = qidsDataset[i][j];
-		}
-  }
-  
   // Crear clases de equivalencia
-  clusters = createClusters(result, qids);
-  return make_tuple(result, clusters);
+  clusters = createClusters(table.decode(), qids);
+  return make_tuple(table, clusters);
 }
@@ -9,17 +9,18 @@ using namespace std;
 
 #include "../utilities/frequencies.h"
 #include "../utilities/hierarchy.h"
+#include "../utilities/table.h"
 #include "../utilities/tree.h"
 #include "generalize.h"
 #include <tuple>
 #include <vector>
 
-bool readyForSuppression(vector<vector<string>> dataset, vector<int> qids,
+bool readyForSuppression(const Table &table, vector<int> qids,
                          const int tableSize, const int K,
                          const long double suppThreshold);
-tuple<vector<vector<string>>, vector<vector<vector<string>>>>
-datafly(vector<vector<string>> dataset,
-        map<int, vector<vector<string>>> hierarchies, vector<int> qids,
-        vector<int> confAtts, const long double suppThreshold, const int K);
+tuple<Table, vector<vector<vector<string>>>>
+datafly(Table table, const map<int, Tree> &trees,
+        vector<int> qids, vector<int> confAtts,
+        const long double suppThreshold, const int K);
 
 #endif
@@ -9,60 +9,70 @@
 
 /*! Comprueba si el conjunto de datos satisface el modelo de privacidad
     k-anonymity.
-  \param dataset conjunto de datos.
+  \param table conjunto de datos codificado.
+  \param qids índices de los atributos qids.
   \param K parámetro del modelo de privacidad k-anonymity.
   \return 1 si el modelo de privacidad se satisface, 0 en otro caso.
 */
-bool isKAnonSatisfied(const vector<vector<string>> dataset, const int K) {
-
-  for (const int &freq : calculateFreqs(dataset)) {
-    if (freq < K) {
-      return false;
-    }
-  }
-
-  return true;
+bool isKAnonSatisfied(const Table &table, const vector<int> &qids,
+                      const int K) {
+  return Grouping(table, qids).minCount() >= K;
 }
 
 /*! Generaliza un conjunto de datos utilizando generalización global sobre
-    un atributo cuasi-identificador dado.
-  \param dataset conjunto de datos.
+    un atributo cuasi-identificador dado. Al tratarse de una recodificación
+    global, basta con generalizar cada valor distinto del diccionario de la
+    columna y traducir los códigos de sus celdas.
+  \param table conjunto de datos codificado.
   \param qid índice del atributo cuasi-identificador o qid.
   \param tree árbol de jerarquía dell atributo qid.
 */
-void generalizeQid(vector<vector<string>> &dataset, const int qid, Tree tree) {
+void generalizeQid(Table &table, const int qid, const Tree &tree) {
+  Column &column = table.getColumn(qid);
+  const vector<string> &dictionary = column.getDictionary();
+
+  // Generalizar únicamente los valores presentes en la columna
+  vector<bool> present(dictionary.size(), false);
+  for (const uint32_t &code : column.getCodes())
+    present[code] = true;
 
-  for (size_t i = 0; i < dataset.size(); i++)
-    dataset[i][qid] = tree.getNextGen(dataset[i][qid]);
+  vector<uint32_t> mapping(dictionary.size(), 0);
+  vector<string> newDictionary;
+  map<string, uint32_t> newCodes;
+  for (size_t i = 0; i < dictionary.size(); i++) {
+    if (!present[i])
+      continue;
+
+    const string gen = tree.getNextGen(dictionary[i]);
+    auto it = newCodes.find(gen);
+    if (it == newCodes.end()) {
+      it = newCodes.emplace(gen, newDictionary.size()).first;
+      newDictionary.emplace_back(gen);
+    }
+    mapping[i] = it->second;
+  }
+
+  column.recode(mapping, newDictionary);
 }
 
 /*! Suprime los registros cuya frecuencia de su conjunto de qids sea
     menor a K.
-  \param dataset conjunto de datos.
+  \param table conjunto de datos codificado.
   \param qids índices de los atributos qids.
   \param K parámetro de la k-anonimidad.
 */
-void supressRecords(vector<vector<string>> &dataset, vector<int> qids,
-                    const int K) {
+void supressRecords(Table &table, vector<int> qids, const int K) {
   // Calcular mapa de frecuencias basado en índices
-  map<string, tuple<int, vector<int>>> records =
-      evaluateFrequencyByIdx(dataset, qids);
+  const Grouping records = evaluateFrequencyByIdx(table, qids);
 
   // Suprimir registros cuya frecuencia de qids sea < K
-  vector<int> deletions;
-  for (const auto &[key, tuple] : records) {
-    int freq = get<0>(tuple);
-    vector<int> idxs = get<1>(tuple);
-
-    if (freq < K) {
-      deletions.insert(deletions.begin(), idxs.begin(), idxs.end());
+  vector<bool> keep(table.numRows(), true);
+  for (size_t g = 0; g < records.numGroups(); g++) {
+    if (records.getCounts()[g] < K) {
+      for (const int &i : records.getRows()[g])
+        keep[i] = false;
     }
   }
 
-  sort(deletions.begin(), deletions.end());
-  int n = 0;
-  for (const auto &i : deletions) {
-    dataset.erase(dataset.begin() + i - n);
-    n++;
-  }
+  table.keepRows(keep);
 }
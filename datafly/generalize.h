@@ -7,14 +7,15 @@
 
 #include "../utilities/frequencies.h"
 #include "../utilities/hierarchy.h"
+#include "../utilities/table.h"
 #include "../utilities/tree.h"
 #include <vector>
 
 using namespace std;
 
-bool isKAnonSatisfied(const vector<vector<string>> dataset, const int K);
-void generalizeQid(vector<vector<string>> &dataset, const int qid, Tree tree);
-void supressRecords(vector<vector<string>> &dataset, vector<int> qids,
-                    const int K);
+bool isKAnonSatisfied(const Table &table, const vector<int> &qids,
+                      const int K);
+void generalizeQid(Table &table, const int qid, const Tree &tree);
+void supressRecords(Table &table, vector<int> qids, const int K);
 
 #endif
@@ -14,15 +14,12 @@
   \return lista de grafos.
 */
 vector<Graph> graphGeneration(const vector<int> &qids, map<int, int> nodeMax,
-                              int numAttr, set<vector<int>> toPrune) {
+                              int numAttr, PruningSet &toPrune) {
   vector<Graph> graphs;
   vector<vector<int>> C;
 
   C = getPermutations(numAttr, qids);
 
-  // Convert set a vector
-  vector<vector<int>> pruneVector(toPrune.begin(), toPrune.end());
-
   // Generate trees for permutations of $perm qids
   for (int perm = 0; perm < (int)C.size(); perm++) {
     vector<int> CMaxValue;
@@ -31,90 +28,196 @@ vector<Graph> graphGeneration(const vector<int> &qids, map<int, int> nodeMax,
     }
 
     // Generar grafo
-    GraphData graphData;
     // C[perm] => índice de qid actual
     // CMaxValue => máximos índices de qids
-    Graph graph(CMaxValue, C[perm], pruneVector, graphData);
+    Graph graph(CMaxValue, C[perm], toPrune);
     graphs.emplace_back(graph);
   }
 
   return graphs;
 }
 
-/*! Genera un mapa de generalizaciones de cada atributo cuasi-identificador.
-  \param hierarchy matriz de jerarquía.
-  \param qids lista de cuasi-identificadores.
-  \return mapa de generalizaciones.
+/*! Calcula el conjunto de frecuencias de un nodo. Si se conoce el de
+    alguno de sus predecesores, agrupa las clases del menor de ellos; en
+    otro caso, recorre los registros del conjunto de datos.
+  \param graph grafo del nodo.
+  \param node índice del nodo.
+  \param frequencySets conjuntos de frecuencias de los nodos evaluados.
+  \param leaves código de la hoja de cada registro en cada qid.
+  \param codes códigos de los valores generalizados de cada qid.
+  \param sensitive evaluador con los códigos de los atributos sensibles.
+  \return conjunto de frecuencias del nodo.
 */
-map<string, vector<string>>
-generateGeneralizationMap(vector<vector<string>> hierarchy, vector<int> qids) {
+FrequencySet
+nodeFrequencySet(const Graph &graph, int node,
+                 const unordered_map<int, FrequencySet> &frequencySets,
+                 const map<int, vector<uint32_t>> &leaves,
+                 const map<int, GeneralizationCodes> &codes,
+                 const TClosenessEvaluator &sensitive) {
+  const GraphNode data = graph.getNode(node);
+  const vector<int> qids = graph.getQids();
+
+  const FrequencySet *parent = nullptr;
+  size_t position = 0;
+  for (size_t j = 0; j < qids.size(); j++) {
+    auto it = frequencySets.find(graph.getPredecessor(node, j));
+    if (it == frequencySets.end())
+      continue;
+    if (parent == nullptr || it->second.size() < parent->size()) {
+      parent = &it->second;
+      position = j;
+    }
+  }
 
-  map<string, vector<string>> genMap;
+  if (parent == nullptr)
+    return data.getFrequencySet(leaves, codes, sensitive, qids);
 
-  for (const auto &entry : hierarchy) {
-    genMap[entry[0]] = entry;
+  const GeneralizationCodes &qidCodes = codes.at(qids[position]);
+  const int level = data.getData(position) - 1;
+  return parent->rollUp(position, qidCodes.getParents(level),
+                        qidCodes.domain(level + 1));
+}
+
+/*! Ejecuta una función para cada índice de un rango, repartiendo los
+    índices entre varios hilos. Con un único hilo se ejecuta de forma
+    secuencial en el hilo actual.
+  \param count número de índices.
+  \param threads número de hilos.
+  \param body función a ejecutar para cada índice.
+*/
+void parallelFor(size_t count, size_t threads,
+                 const function<void(size_t)> &body) {
+  if (threads <= 1 || count <= 1) {
+    for (size_t i = 0; i < count; i++)
+      body(i);
+    return;
   }
 
-  return genMap;
+  atomic<size_t> next(0);
+  mutex lock;
+  exception_ptr error;
+  auto run = [&]() {
+    for (size_t i = next++; i < count; i = next++) {
+      try {
+        body(i);
+      } catch (...) {
+        lock_guard<mutex> guard(lock);
+        if (!error)
+          error = current_exception();
+      }
+    }
+  };
+
+  vector<thread> workers;
+  for (size_t t = 1; t < min(threads, count); t++)
+    workers.emplace_back(run);
+  run();
+  for (thread &worker : workers)
+    worker.join();
+
+  if (error)
+    rethrow_exception(error);
 }
 
-/*! Genera mapas de generalizaciones para cada atributo cuasi-identificador.
-  \param hierarchy mapa de matrices de jerarquías.
-  \param qids lista de cuasi-identificadores.
-  \return mapa de generalizaciones.
+/*! Recorre el grafo de un subconjunto de qids, de menor a mayor altura,
+    marcando los nodos que cumplen los modelos de privacidad. Los nodos de
+    una misma altura no dependen entre sí, por lo que se evalúan en
+    paralelo y se aplican después en orden, de modo que el resultado no
+    depende del número de hilos.
+  \param g grafo.
+  \param leaves código de la hoja de cada registro en cada qid.
+  \param codes códigos de los valores generalizados de cada qid.
+  \param tcloseness evaluador con los códigos y la distribución global de
+                    los atributos sensibles.
+  \param K parámetro de la k-anonimidad.
+  \param L parámetro de la l-diversidad.
+  \param T parámetro de t-closeness.
+  \param threads número de hilos.
+  \param failed nodos que no cumplen los modelos de privacidad, como
+                entradas del vector de poda.
 */
-map<int, map<string, vector<string>>>
-generateGeneralizationsMap(map<int, vector<vector<string>>> hierarchies,
-                           vector<int> qids) {
+void evaluateGraph(Graph &g, const map<int, vector<uint32_t>> &leaves,
+                   const map<int, GeneralizationCodes> &codes,
+                   const TClosenessEvaluator &tcloseness, const int K,
+                   const int L, const long double T, const size_t threads,
+                   PruningSet &failed) {
+  // Nodos pendientes agrupados por altura: los sucesores de un nodo
+  // siempre se evalúan después que él
+  vector<vector<int>> nodesQueue(g.getMaxHeight() + 1);
+  vector<bool> queued(g.size(), false);
+  for (const int &node : g.getLeaves()) {
+    queued[node] = true;
+    nodesQueue[g.getHeight(node)].emplace_back(node);
+  }
 
-  map<int, map<string, vector<string>>> gensMap;
-  for (const auto &qid : qids)
-    gensMap[qid] = generateGeneralizationMap(hierarchies[qid], qids);
+  // Conjuntos de frecuencias de los nodos evaluados que no cumplen los
+  // modelos de privacidad, de los que se obtienen los de sus sucesores
+  unordered_map<int, FrequencySet> frequencySets;
+
+  // Bucle principal
+  for (size_t height = 0; height < nodesQueue.size(); height++) {
+    // Solo los predecesores, de la altura anterior, marcan un nodo
+    vector<int> frontier;
+    for (const int &node : nodesQueue[height]) {
+      if (!g.isNodeMarked(node))
+        frontier.emplace_back(node);
+    }
 
-  return gensMap;
+    vector<FrequencySet> sets(frontier.size());
+    vector<char> valid(frontier.size());
+    parallelFor(frontier.size(), threads, [&](size_t f) {
+      sets[f] = nodeFrequencySet(g, frontier[f], frequencySets, leaves,
+                                 codes, tcloseness);
+      valid[f] = isFrequencySetValid(sets[f], tcloseness, K, L, T);
+    });
+
+    for (size_t f = 0; f < frontier.size(); f++) {
+      const int node = frontier[f];
+      if (valid[f]) {
+        g.markGeneralizations(node);
+      } else {
+        // Añadir nodo al vector de poda
+        failed.insert(g.getPruningKey(node));
+        g.addGeneralizations(node, nodesQueue, queued);
+        frequencySets[node] = move(sets[f]);
+      }
+    }
+
+    // Los nodos de la altura siguiente solo se obtienen a partir de los
+    // de esta altura
+    if (height > 0) {
+      for (const int &node : nodesQueue[height - 1])
+        frequencySets.erase(node);
+    }
+  }
 }
 
 /*! Anonimiza un conjunto de datos.  
   \param dataset conjunto de datos.
-  \param hierarchiesMap tablas de jerarquías.
-  \param gens mapa de generalizaciones.
+  \param leaves código de la hoja de cada registro en cada qid.
+  \param codes códigos de los valores generalizados de cada qid.
   \param graphs lista de grafos.
   \param qids lista de cuasi-identificadores.
   \return matriz de datos anonimizados.
 */
 vector<vector<string>>
-generateAnonymizedDataset(vector<vector<string>> dataset,
-                          map<int, vector<vector<string>>> hierarchiesMap,
-                          map<int, map<string, vector<string>>> gens,
-                          vector<Graph> graphs, vector<int> qids) {
+generateAnonymizedDataset(const vector<vector<string>> &dataset,
+                          const map<int, vector<uint32_t>> &leaves,
+                          const map<int, GeneralizationCodes> &codes,
+                          vector<Graph> &graphs, const vector<int> &qids) {
   // Seleccionar un nodo de entre todos los que satisfacen K.
   // Criterio: nodo que produzca el máximo número de clases de equivalencia.
-  const GraphNode node = graphs.back().getFinalKAnon(gens, dataset, qids);
+  const GraphNode node = graphs.back().getFinalKAnon(leaves, codes, qids);
   vector<int> data = node.getData();
 
-  map<int, map<string, string>> generalizations;
-  for (size_t i = 0; i < qids.size(); i++) {
-    const int qid = qids[i];
-    map<string, string> qidMap;
-
-    for (size_t j = 0; j < hierarchiesMap[qid][0].size(); j++)
-      qidMap[hierarchiesMap[qid][0][j]] = hierarchiesMap[qid][data[i]][j];
-
-    generalizations[qid] = qidMap;
-  }
-
-  vector<vector<string>> result;
-  for (size_t i = 0; i < dataset.size(); i++) {
-    vector<string> row;
-    for (size_t j = 0; j < dataset[0].size(); j++) {
-      auto it = find(qids.begin(), qids.end(), j);
-      if (it != qids.end()) {
-        row.emplace_back(generalizations[j][dataset[i][j]]);
-        continue;
-      }
-      row.emplace_back(dataset[i][j]);
+  vector<vector<string>> result = dataset;
+  for (size_t j = 0; j < qids.size(); j++) {
+    const vector<uint32_t> &qidLeaves = leaves.at(qids[j]);
+    const GeneralizationCodes &qidCodes = codes.at(qids[j]);
+    for (size_t i = 0; i < result.size(); i++) {
+      const uint32_t code = qidCodes.generalize(qidLeaves[i], data[j]);
+      result[i][qids[j]] = qidCodes.decode(data[j], code);
     }
-    result.emplace_back(row);
   }
 
   return result;
@@ -125,72 +228,65 @@ generateAnonymizedDataset(vector<vector<string>> dataset,
   \param hierarchies tablas de jerarquías.
   \param qids lista de cuasi-identificadores.
   \param confAtts lista de índices de atributos sensibles.
+  \param orderedAtts atributos sensibles numéricos, que utilizan la distancia
+                     ordenada en t-closeness.
   \param K parámetro de la k-anonimidad.
   \param L parámetro de la l-diversidad.
   \param T parámetro de t-closeness.
+  \param threads número de hilos (0 para utilizar todos los núcleos).
   \return tupla compuesta por la matriz de datos anonimizados y el conjunto de clases
           de equivalencia que lo forman.
 */
 tuple<vector<vector<string>>, vector<vector<vector<string>>>>
 incognito(vector<vector<string>> dataset,
-          map<int, vector<vector<string>>> hierarchies, vector<int> qids,
-          vector<int> confAtts, const int K, const int L, const long double T) {
+          const map<int, vector<vector<string>>> &hierarchies, vector<int> qids,
+          vector<int> confAtts, vector<int> orderedAtts, const int K,
+          const int L, const long double T, const int threads) {
 
-  // Generar datos auxiliares a utilizar para determinar t-closeness
-  tuple<vector<map<string, int>>, vector<set<string>>> dataMap;
-  if (T != -1)
-    dataMap = createDataMap(dataset, confAtts);
+  // Códigos de los atributos sensibles, utilizados en los histogramas de
+  // cada clase, y su distribución global, utilizada para determinar
+  // t-closeness
+  TClosenessEvaluator tcloseness;
+  if (L > 0 || T > 0)
+    tcloseness = TClosenessEvaluator(dataset, confAtts, orderedAtts);
 
   // Niveles de generalización máximos (jerarquias) de cada qid
   map<int, int> nodeMax;
   for (const int &qid : qids) {
-    nodeMax[qid] = hierarchies[qid].size() - 1;
+    nodeMax[qid] = hierarchies.at(qid).size() - 1;
   }
-  // Mapas de jerarquias transpuestos
-  map<int, vector<vector<string>>> transposedHierarchies;
-  for (const auto &qid : qids) {
-    transposedHierarchies[qid] = transpose(hierarchies[qid]);
+  // Códigos de los valores generalizados de cada qid y código de la hoja
+  // de cada registro, calculados una única vez
+  map<int, GeneralizationCodes> codes;
+  map<int, vector<uint32_t>> leaves;
+  for (const int &qid : qids) {
+    codes[qid] = GeneralizationCodes(hierarchies.at(qid));
+    leaves[qid] = codes[qid].encodeLeaves(dataset, qid);
   }
-  // Conjunto de datos transpuesto
-  vector<vector<string>> transposedDataset;
-  transposedDataset = transpose(dataset);
-
-  // Generate a generalization map
-  map<int, map<string, vector<string>>> gensMap =
-      generateGeneralizationsMap(transposedHierarchies, qids);
 
   // generar todos los posibles grafos en función de los qids y
   // los niveles de generalización máximos (nodeMax)
-  vector<Graph> graphs = graphGeneration(qids, nodeMax, 1, {});
+  PruningSet pruningVector;
+  vector<Graph> graphs = graphGeneration(qids, nodeMax, 1, pruningVector);
 
-  // Procedimiento principal del algoritmo
+  // Procedimiento principal del algoritmo. Los grafos de un mismo tamaño
+  // se evalúan en paralelo, repartiendo los hilos entre ellos
+  const size_t nThreads = poolThreads(threads);
   vector<Graph> rGraphs;
-  set<vector<int>> pruningVector;
   for (size_t i = 1; i < qids.size() + 1; i++) {
-    for (size_t gsize = 0; gsize < graphs.size(); gsize++) {
-      Graph g = graphs[gsize];
-      set<GraphNode> nodesQueue = g.getLeaves();
-      vector<GraphNode> kanon;
-
-      // Bucle principal
-      while (!nodesQueue.empty()) {
-        GraphNode node = *(nodesQueue.begin());
-        nodesQueue.erase(nodesQueue.begin());
-
-        if (!g.isNodeMarked(node)) {
-          // No marcado
-          if (node.isAnonymityValid(hierarchies, dataset, gensMap, dataMap,
-                                    g.getQids(), confAtts, K, L, T)) {
-            g.markGeneralizations(node);
-          } else {
-            // Añadir nodo al vector de poda
-            pruningVector.insert(node.getData());
-            g.addGeneralizations(node, nodesQueue);
-          }
-        }
-      }
+    const size_t graphThreads = max((size_t)1, min(nThreads, graphs.size()));
+    const size_t nodeThreads = max((size_t)1, nThreads / graphThreads);
 
-      rGraphs.emplace_back(g);
+    vector<PruningSet> failed(graphs.size());
+    parallelFor(graphs.size(), graphThreads, [&](size_t gsize) {
+      evaluateGraph(graphs[gsize], leaves, codes, tcloseness, K, L, T,
+                    nodeThreads, failed[gsize]);
+    });
+
+    // Fusionar los vectores de poda de cada grafo
+    for (size_t gsize = 0; gsize < graphs.size(); gsize++) {
+      pruningVector.insert(failed[gsize].begin(), failed[gsize].end());
+      rGraphs.emplace_back(graphs[gsize]);
     }
 
     // Generar grafos
@@ -200,7 +296,7 @@ incognito(vector<vector<string>> dataset,
 
   // Construir dataset anonimizado
   vector<vector<string>> result =
-      generateAnonymizedDataset(dataset, hierarchies, gensMap, rGraphs, qids);
+      generateAnonymizedDataset(dataset, leaves, codes, rGraphs, qids);
 
   // Crear clases de equivalencia
   return make_tuple(result, createClusters(result, qids));
@@ -9,14 +9,25 @@ using namespace std;
 
 #include "../utilities/frequencies.h"
 #include "../utilities/hierarchy.h"
+#include "../utilities/sweep.h"
+#include "anonymity.h"
+#include "frequencySet.h"
+#include "generalizationCodes.h"
 #include "graph.h"
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <thread>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 tuple<vector<vector<string>>, vector<vector<vector<string>>>>
 incognito(vector<vector<string>> dataset,
-          map<int, vector<vector<string>>> hierarchies, vector<int> qids,
-          vector<int> confAtts, const int K, const int L, const long double T);
+          const map<int, vector<vector<string>>> &hierarchies, vector<int> qids,
+          vector<int> confAtts, vector<int> orderedAtts, const int K,
+          const int L, const long double T, const int threads);
 
 #endif
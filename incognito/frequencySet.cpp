@@ -0,0 +1,163 @@
+/*! \file frequencySet.cpp
+    \brief Fichero que contiene la clase FrequencySet, conjunto de
+           frecuencias de un nodo del retículo de incognito.
+*/
+
+#include "frequencySet.h"
+
+// Constructor vacio de la clase FrequencySet.
+FrequencySet::FrequencySet() {}
+
+/*! Constructor de la clase FrequencySet a partir de los registros del
+    conjunto de datos.
+  \param codes código generalizado de cada qid (fila) en cada registro
+               (columna).
+  \param radices número de códigos distintos de cada qid.
+  \param sensitive evaluador con los códigos de los atributos sensibles de
+                   cada registro. Si no contiene atributos, el conjunto no
+                   guarda histogramas.
+*/
+FrequencySet::FrequencySet(const vector<vector<uint32_t>> &codes,
+                           const vector<uint32_t> &radices,
+                           const TClosenessEvaluator &sensitive) {
+  const size_t numRows = codes.empty() ? 0 : codes[0].size();
+
+  // Cada registro forma su propia clase
+  FrequencySet rows;
+  rows.counts.assign(numRows, 1);
+  for (size_t att = 0; att < sensitive.size(); att++) {
+    rows.domains.emplace_back(sensitive.domain(att));
+    rows.offsets.emplace_back(numRows + 1);
+    for (size_t i = 0; i <= numRows; i++)
+      rows.offsets[att][i] = i;
+    rows.values.emplace_back(sensitive.getCodes(att));
+    rows.frequencies.emplace_back(numRows, 1);
+  }
+
+  *this = rows.merge(codes, radices);
+}
+
+/*! Agrupa las clases del conjunto cuyos códigos coinciden, sumando su
+    número de registros y sus histogramas.
+  \param keys código de cada qid en cada clase del conjunto.
+  \param radices número de códigos distintos de cada qid.
+  \return conjunto de frecuencias agrupado.
+*/
+FrequencySet FrequencySet::merge(const vector<vector<uint32_t>> &keys,
+                                 const vector<uint32_t> &radices) const {
+  vector<const uint32_t *> columns;
+  for (const vector<uint32_t> &column : keys)
+    columns.emplace_back(column.data());
+  const vector<vector<int>> classes =
+      QidKeyEncoder(radices).equivalenceClasses(columns, size());
+
+  FrequencySet result;
+  result.radices = radices;
+  result.domains = this->domains;
+  result.keys.resize(keys.size());
+  for (size_t j = 0; j < keys.size(); j++) {
+    result.keys[j].reserve(classes.size());
+    for (const vector<int> &members : classes)
+      result.keys[j].emplace_back(keys[j][members[0]]);
+  }
+
+  result.counts.reserve(classes.size());
+  for (const vector<int> &members : classes) {
+    int count = 0;
+    for (const int &group : members)
+      count += this->counts[group];
+    result.counts.emplace_back(count);
+  }
+
+  // Histogramas: se acumulan en un vector denso, del que solo se
+  // recorren las entradas modificadas
+  const size_t numSensitive = this->domains.size();
+  result.offsets.resize(numSensitive);
+  result.values.resize(numSensitive);
+  result.frequencies.resize(numSensitive);
+  for (size_t att = 0; att < numSensitive; att++) {
+    vector<int> histogram(this->domains[att], 0);
+    vector<int> touched;
+    result.offsets[att].reserve(classes.size() + 1);
+    result.offsets[att].emplace_back(0);
+
+    for (const vector<int> &members : classes) {
+      for (const int &group : members) {
+        for (int e = this->offsets[att][group];
+             e < this->offsets[att][group + 1]; e++) {
+          const int value = this->values[att][e];
+          if (histogram[value] == 0)
+            touched.emplace_back(value);
+          histogram[value] += this->frequencies[att][e];
+        }
+      }
+
+      for (const int &value : touched) {
+        result.values[att].emplace_back(value);
+        result.frequencies[att].emplace_back(histogram[value]);
+        histogram[value] = 0;
+      }
+      touched.clear();
+      result.offsets[att].emplace_back(result.values[att].size());
+    }
+  }
+
+  return result;
+}
+
+/*! Calcula el conjunto de frecuencias del nodo que generaliza un nivel más
+    uno de los qids.
+  \param qid posición del qid generalizado.
+  \param parents código en el nivel siguiente de cada código del qid.
+  \param radix número de códigos distintos del qid en el nivel siguiente.
+  \return conjunto de frecuencias de la generalización.
+*/
+FrequencySet FrequencySet::rollUp(size_t qid, const vector<uint32_t> &parents,
+                                  uint32_t radix) const {
+  vector<vector<uint32_t>> keys = this->keys;
+  for (uint32_t &code : keys[qid])
+    code = parents[code];
+
+  vector<uint32_t> radices = this->radices;
+  radices[qid] = radix;
+  return merge(keys, radices);
+}
+
+/*! Devuelve el número de clases de equivalencia.
+  \return número de clases.
+*/
+size_t FrequencySet::size() const { return this->counts.size(); }
+
+/*! Devuelve el número de atributos sensibles con histograma.
+  \return número de atributos.
+*/
+size_t FrequencySet::numSensitive() const { return this->domains.size(); }
+
+/*! Devuelve el número de registros de una clase.
+  \param group índice de la clase.
+  \return número de registros.
+*/
+int FrequencySet::getCount(size_t group) const { return this->counts[group]; }
+
+/*! Devuelve el número de valores distintos de un atributo sensible en una
+    clase.
+  \param att posición del atributo sensible.
+  \param group índice de la clase.
+  \return número de valores distintos.
+*/
+int FrequencySet::getDistinct(size_t att, size_t group) const {
+  return this->offsets[att][group + 1] - this->offsets[att][group];
+}
+
+/*! Obtiene el histograma denso de un atributo sensible en una clase.
+  \param att posición del atributo sensible.
+  \param group índice de la clase.
+  \param histogram frecuencia de cada código del atributo en la clase.
+*/
+void FrequencySet::getHistogram(size_t att, size_t group,
+                                vector<int> &histogram) const {
+  histogram.assign(this->domains[att], 0);
+  for (int e = this->offsets[att][group]; e < this->offsets[att][group + 1];
+       e++)
+    histogram[this->values[att][e]] = this->frequencies[att][e];
+}
@@ -0,0 +1,50 @@
+/*! \file frequencySet.h
+    \brief Fichero de cabecera del archivo frequencySet.cpp.
+*/
+
+#ifndef _FREQUENCYSET_H
+#define _FREQUENCYSET_H
+
+#include "../utilities/qidKey.h"
+#include "../utilities/tCloseness.h"
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/*! Clase FrequencySet. Conjunto de frecuencias de un nodo del retículo: por
+    cada clase de equivalencia, el código generalizado de cada qid, su
+    número de registros y el histograma disperso (código, frecuencia) de
+    cada atributo sensible. El conjunto de frecuencias de una generalización
+    se obtiene agrupando las clases de otro nodo más específico, sin
+    recorrer de nuevo los registros.
+*/
+class FrequencySet {
+private:
+  vector<vector<uint32_t>> keys;
+  vector<uint32_t> radices;
+  vector<int> counts;
+  vector<int> domains;
+  vector<vector<int>> offsets;
+  vector<vector<int>> values;
+  vector<vector<int>> frequencies;
+
+  FrequencySet merge(const vector<vector<uint32_t>> &keys,
+                     const vector<uint32_t> &radices) const;
+
+public:
+  // Constructors
+  FrequencySet();
+  FrequencySet(const vector<vector<uint32_t>> &codes,
+               const vector<uint32_t> &radices,
+               const TClosenessEvaluator &sensitive);
+  FrequencySet rollUp(size_t qid, const vector<uint32_t> &parents,
+                      uint32_t radix) const;
+  size_t size() const;
+  size_t numSensitive() const;
+  int getCount(size_t group) const;
+  int getDistinct(size_t att, size_t group) const;
+  void getHistogram(size_t att, size_t group, vector<int> &histogram) const;
+};
+
+#endif
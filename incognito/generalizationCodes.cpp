@@ -0,0 +1,115 @@
+/*! \file generalizationCodes.cpp
+    \brief Fichero que contiene la clase GeneralizationCodes, con los
+           códigos de los valores generalizados de un qid.
+*/
+
+#include "generalizationCodes.h"
+
+// Constructor vacio de la clase GeneralizationCodes.
+GeneralizationCodes::GeneralizationCodes() {}
+
+/*! Constructor de la clase GeneralizationCodes. Los códigos de cada nivel
+    siguen el orden de aparición de los valores en la jerarquía.
+  \param hierarchy jerarquía del qid, organizada por niveles: la fila i
+                   contiene la generalización de cada hoja en el nivel i.
+*/
+GeneralizationCodes::GeneralizationCodes(
+    const vector<vector<string>> &hierarchy) {
+  const size_t numLevels = hierarchy.size();
+  this->codes.resize(numLevels);
+  this->parents.resize(numLevels - 1);
+  this->values.resize(numLevels);
+
+  vector<uint32_t> leafCodes(numLevels);
+  for (size_t j = 0; j < hierarchy[0].size(); j++) {
+    for (size_t level = 0; level < numLevels; level++) {
+      unordered_map<string, uint32_t> &levelCodes = this->codes[level];
+      auto [it, inserted] =
+          levelCodes.emplace(hierarchy[level][j], levelCodes.size());
+      if (inserted)
+        this->values[level].emplace_back(hierarchy[level][j]);
+      leafCodes[level] = it->second;
+
+      // El padre de un valor queda fijado por la primera hoja en la que
+      // aparece
+      if (level > 0 &&
+          leafCodes[level - 1] == this->parents[level - 1].size())
+        this->parents[level - 1].emplace_back(it->second);
+    }
+
+    // Si una hoja se repite, prevalece su última aparición
+    const size_t leaf = leafCodes[0];
+    if (leaf * numLevels == this->generalizations.size())
+      this->generalizations.resize((leaf + 1) * numLevels);
+    copy(leafCodes.begin(), leafCodes.end(),
+         this->generalizations.begin() + leaf * numLevels);
+  }
+}
+
+/*! Devuelve el nivel de generalización máximo del qid.
+  \return nivel máximo.
+*/
+int GeneralizationCodes::getMaxLevel() const {
+  return (int)this->codes.size() - 1;
+}
+
+/*! Devuelve el número de valores distintos de un nivel.
+  \param level nivel de generalización.
+  \return número de valores.
+*/
+uint32_t GeneralizationCodes::domain(int level) const {
+  return this->codes[level].size();
+}
+
+/*! Devuelve el código de un valor generalizado.
+  \param level nivel de generalización del valor.
+  \param value valor generalizado.
+  \return código del valor.
+*/
+uint32_t GeneralizationCodes::encode(int level, const string &value) const {
+  auto it = this->codes[level].find(value);
+  if (it == this->codes[level].end())
+    throw "Error: Generalized value not found in the hierarchy";
+  return it->second;
+}
+
+/*! Devuelve el código del padre de cada valor de un nivel.
+  \param level nivel de generalización, menor que el máximo.
+  \return código en el nivel siguiente de cada código del nivel.
+*/
+const vector<uint32_t> &GeneralizationCodes::getParents(int level) const {
+  return this->parents[level];
+}
+
+/*! Codifica como hojas de la jerarquía los valores de un atributo del
+    conjunto de datos.
+  \param dataset conjunto de datos.
+  \param att posición del atributo.
+  \return código de la hoja de cada registro.
+*/
+vector<uint32_t>
+GeneralizationCodes::encodeLeaves(const vector<vector<string>> &dataset,
+                                  int att) const {
+  vector<uint32_t> leaves(dataset.size());
+  for (size_t i = 0; i < dataset.size(); i++)
+    leaves[i] = encode(0, dataset[i][att]);
+  return leaves;
+}
+
+/*! Devuelve el código de la generalización de una hoja en un nivel.
+  \param leaf código de la hoja.
+  \param level nivel de generalización.
+  \return código del valor generalizado.
+*/
+uint32_t GeneralizationCodes::generalize(uint32_t leaf, int level) const {
+  return this->generalizations[leaf * this->codes.size() + level];
+}
+
+/*! Devuelve el valor generalizado correspondiente a un código.
+  \param level nivel de generalización del valor.
+  \param code código del valor.
+  \return valor generalizado.
+*/
+const string &GeneralizationCodes::decode(int level, uint32_t code) const {
+  return this->values[level][code];
+}
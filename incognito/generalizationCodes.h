@@ -0,0 +1,45 @@
+/*! \file generalizationCodes.h
+    \brief Fichero de cabecera del archivo generalizationCodes.cpp.
+*/
+
+#ifndef _GENERALIZATIONCODES_H
+#define _GENERALIZATIONCODES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/*! Clase GeneralizationCodes. Codifica como enteros densos los valores de
+    cada nivel de generalización de la jerarquía de un qid, y guarda el
+    código del padre (nivel siguiente) de cada uno de ellos. Permite
+    agrupar las clases de equivalencia de un nivel en las del siguiente sin
+    volver a generalizar los registros. La generalización de cada hoja en
+    cada nivel se guarda en una tabla plana, indexada por el código de la
+    hoja y el nivel, que sustituye a las búsquedas por cadena.
+*/
+class GeneralizationCodes {
+private:
+  vector<unordered_map<string, uint32_t>> codes;
+  vector<vector<uint32_t>> parents;
+  vector<uint32_t> generalizations;
+  vector<vector<string>> values;
+
+public:
+  // Constructors
+  GeneralizationCodes();
+  GeneralizationCodes(const vector<vector<string>> &hierarchy);
+  int getMaxLevel() const;
+  uint32_t domain(int level) const;
+  uint32_t encode(int level, const string &value) const;
+  const vector<uint32_t> &getParents(int level) const;
+  vector<uint32_t> encodeLeaves(const vector<vector<string>> &dataset,
+                                int att) const;
+  uint32_t generalize(uint32_t leaf, int level) const;
+  const string &decode(int level, uint32_t code) const;
+};
+
+#endif
@@ -4,80 +4,121 @@
 
 #include "graph.h"
 
+/*! Calcula el hash de una entrada del vector de poda.
+  \param key entrada del vector de poda.
+  \return hash de la entrada.
+*/
+size_t PruningKeyHash::operator()(const vector<int> &key) const {
+  size_t hash = key.size();
+  for (const int &value : key)
+    hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
 // Constructor de la clase Graph.
 Graph::Graph(){};
 
 /*! Constructor de la clase Graph.
   \param nodesMax valor máximo de cada qid.
   \param qids lista de cuasi-identificadores.
-  \param toPrune vector de poda.
-  \param graphData clase que contiene los datos del grafo.
+  \param toPrune vector de poda, con los nodos que no cumplen los modelos
+                 de privacidad de los subconjuntos de qids ya evaluados.
+                 Se añaden los nodos podados del grafo.
 */
-Graph::Graph(vector<int> nodesMax, vector<int> qids,
-             vector<vector<int>> toPrune, GraphData &graphData) {
-  this->graphData = graphData;
+Graph::Graph(const vector<int> &nodesMax, const vector<int> &qids,
+             PruningSet &toPrune)
+    : lattice(nodesMax) {
   this->qids = qids;
-  generateNodesAndEdges(nodesMax, toPrune);
+  // Fase de poda
+  pruneNodes(toPrune);
 }
 
-/*! Función principal sobre la que se generan los contenidos del
-    grafo.
-  \param nodesMax valores de generalización máximos de cada qid.
-  \param toPrune vector de poda.
+/*! Poda los nodos cuya proyección sobre un subconjunto de sus qids no
+    cumple los modelos de privacidad. Si una generalización de un
+    subconjunto de qids no los cumple, ninguna generalización del conjunto
+    completo con los mismos niveles en esos qids puede cumplirlos. Basta con
+    comprobar los subconjuntos con un qid menos, ya que los nodos podados
+    también se añaden al vector de poda.
+  \param toPrune vector de poda. Cada entrada alterna el índice de un qid y
+                 su nivel de generalización (ver getPruningKey).
 */
-void Graph::generateNodesAndEdges(const vector<int> &nodesMax,
-                                  vector<vector<int>> toPrune) {
-  int nsize = nodesMax.size();
-  vector<int> inode(nsize, 0);
-  this->graphData.addData(inode);
-
-  int index = 0;
-  generateAllNodes(inode, nodesMax, nsize, index);
-  // Fase de poda
-  this->graphData.pruneNodes(toPrune);
-  this->graphData.generateAllEdges();
-  this->graphData.setRoot();
-  return;
+void Graph::pruneNodes(PruningSet &toPrune) {
+  if (this->qids.size() < 2)
+    return;
+
+  vector<int> projection;
+  for (int node = 0; node < this->lattice.size(); node++) {
+    const vector<int> key = getPruningKey(node);
+    for (size_t j = 0; j < key.size(); j += 2) {
+      // Proyección del nodo sin el qid j
+      projection.assign(key.begin(), key.begin() + j);
+      projection.insert(projection.end(), key.begin() + j + 2, key.end());
+      if (toPrune.count(projection)) {
+        this->lattice.prune(node);
+        toPrune.insert(key);
+        break;
+      }
+    }
+  }
 }
 
-/*! Genera todos los nodos del grafo.
-  \param nodes lista de nodos.
-  \param nodesMax valores de generalización máximos de cada qid.
-  \param nsize número de nodos.
-  \param index índice auxiliar.
+/*! Devuelve el número de nodos del grafo, incluidos los podados.
+  \return número de nodos.
 */
-void Graph::generateAllNodes(const vector<int> &nodes,
-                             const vector<int> &nodesMax, int nsize,
-                             int index) {
-  vector<vector<int>> aux;
+int Graph::size() const { return this->lattice.size(); }
 
-  for (int i = 0; i < nsize; i++) {
-    vector<int> nodeAux = nodes;
-    if (nodes[i] < nodesMax[i]) {
-      nodeAux[i] += 1;
+/*! Devuelve el nodo raíz del grafo, el más general.
+  \return nodo raíz.
+*/
+int Graph::getRoot() const { return this->lattice.getTop(); }
 
-      // Crear nodo y arista
-      this->graphData.addData(nodeAux);
+/*! Devuelve los nodos hojas del grafo, los que no tienen predecesores.
+  \return lista de nodos.
+*/
+vector<int> Graph::getLeaves() const { return this->lattice.getBottoms(); }
 
-      index += 1;
-      aux.emplace_back(nodeAux);
-    }
-  }
+/*! Devuelve la altura de un nodo.
+  \param node índice del nodo.
+  \return altura del nodo.
+*/
+int Graph::getHeight(int node) const { return this->lattice.getHeight(node); }
 
-  for (const vector<int> &entry : aux) {
-    generateAllNodes(entry, nodesMax, nsize, index);
-  }
+/*! Devuelve la altura del nodo raíz.
+  \return altura máxima.
+*/
+int Graph::getMaxHeight() const { return this->lattice.getMaxHeight(); }
+
+/*! Devuelve los datos de un nodo.
+  \param node índice del nodo.
+  \return nodo.
+*/
+GraphNode Graph::getNode(int node) const {
+  return GraphNode(node, this->lattice.decode(node));
 }
 
-/*! Devuelve el nodo raíz del grafo.
-  \return nodo raíz.
+/*! Devuelve el predecesor de un nodo que especializa un nivel uno de sus
+    qids.
+  \param node índice del nodo.
+  \param j posición del qid.
+  \return índice del predecesor, o -1 si no se encuentra en el grafo.
 */
-GraphNode Graph::getRoot() { return this->graphData.getRoot(); }
+int Graph::getPredecessor(int node, int j) const {
+  return this->lattice.getPredecessor(node, j);
+}
 
-/*! Devuelve todos los nodos hojas del grafo.
-  \return lista de nodos.
+/*! Devuelve la entrada del vector de poda de un nodo: el índice de cada
+    qid seguido de su nivel de generalización.
+  \param node índice del nodo.
+  \return entrada del vector de poda.
 */
-set<GraphNode> Graph::getLeaves() { return this->graphData.getLeaves(); }
+vector<int> Graph::getPruningKey(int node) const {
+  vector<int> key;
+  for (size_t j = 0; j < this->qids.size(); j++) {
+    key.emplace_back(this->qids[j]);
+    key.emplace_back(this->lattice.getLevel(node, j));
+  }
+  return key;
+}
 
 /*! Devuelve la lista de índices de qids.
   \return lista de qids.
@@ -85,28 +126,82 @@ set<GraphNode> Graph::getLeaves() { return this->graphData.getLeaves(); }
 vector<int> Graph::getQids() const { return this->qids; }
 
 /*! Comprueba si un nodo se encuentra marcado.
+  \param node índice del nodo.
   \return 1 si se encuentra marcado, 0 si no es así.
 */
-bool Graph::isNodeMarked(GraphNode node) {
-  return this->graphData.isNodeMarked(node);
+bool Graph::isNodeMarked(int node) const {
+  return this->lattice.isMarked(node);
 }
 
-/*! Añade las generalizaciones de un nodo.
+/*! Añade las generalizaciones (sucesores) que no se encuentran marcadas
+    de un nodo a la cola, agrupada por altura.
   \param node nodo inicial.
-  \param queue nodos generalizaciones del anterior.
-  \return -1 si el nodo dado es la raíz, 0 si la función se ejecuta
-          correctamente.
+  \param queue nodos pendientes de cada altura.
+  \param queued nodos que ya se han añadido a la cola.
 */
-int Graph::addGeneralizations(const GraphNode &node, set<GraphNode> &queue) {
-  return this->graphData.addGeneralizations(node, queue);
+void Graph::addGeneralizations(int node, vector<vector<int>> &queue,
+                               vector<bool> &queued) const {
+  for (const int &successor : this->lattice.getSuccessors(node)) {
+    if (!queued[successor] && !this->lattice.isMarked(successor)) {
+      queued[successor] = true;
+      queue[this->lattice.getHeight(successor)].emplace_back(successor);
+    }
+  }
 }
 
-void Graph::markGeneralizations(const GraphNode &node) {
-  this->graphData.markGeneralizations(node);
+/*! Marca el nodo dado y sus generalizaciones directas como nodos que
+    cumplen con los modelos de privacidad.
+  \param node nodo.
+*/
+void Graph::markGeneralizations(int node) {
+  this->lattice.setKAnon(node);
+  this->lattice.mark(node);
+
+  for (const int &successor : this->lattice.getSuccessors(node)) {
+    this->lattice.mark(successor);
+    this->lattice.setKAnon(successor);
+  }
 }
 
-GraphNode Graph::getFinalKAnon(map<int, map<string, vector<string>>> gens,
-                               vector<vector<string>> dataset,
-                               vector<int> qids) {
-  return graphData.getFinalKAnon(gens, dataset, qids);
+/*! Calcula el nodo final sobre el que se generalizará el conjunto
+    de datos, de entre todos los nodos que cumplen los modelos de privacidad,
+    seleccionando uno en función de un criterio específico. Los nodos se
+    recorren de menor a mayor altura, por lo que ante un empate se
+    selecciona el menos generalizado.
+  \param leaves código de la hoja de cada registro en cada qid.
+  \param codes códigos de los valores generalizados de cada qid.
+  \param qids lista de atributos cuasi-identificadores.
+  \return nodo resultante.
+*/
+GraphNode Graph::getFinalKAnon(const map<int, vector<uint32_t>> &leaves,
+                               const map<int, GeneralizationCodes> &codes,
+                               const vector<int> &qids) {
+  vector<int> res;
+  for (int node = 0; node < this->lattice.size(); node++) {
+    if (this->lattice.isKAnon(node))
+      res.emplace_back(node);
+  }
+
+  // Si ningún nodo cumple el criterio devolvemos el nodo raíz
+  if (res.size() == 0)
+    return getNode(getRoot());
+
+  stable_sort(res.begin(), res.end(), [this](int a, int b) {
+    return this->lattice.getHeight(a) < this->lattice.getHeight(b);
+  });
+
+  // Obtener un nodo en función de un criterio
+  // En este caso el que maximice el número de clases
+  int max = -1;
+  GraphNode finalNode;
+  for (const int &node : res) {
+    vector<int> freqs = getNode(node).evaluateFrequency(leaves, codes, qids);
+
+    if ((int)freqs.size() > max || max == -1) {
+      max = freqs.size();
+      finalNode = getNode(node);
+    }
+  }
+
+  return finalNode;
 }
@@ -5,36 +5,53 @@
 #ifndef _GRAPH_H
 #define _GRAPH_H
 
-#include "graphData.h"
+#include "graphNode.h"
+#include "lattice.h"
+#include <algorithm>
 #include <iostream>
+#include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 using namespace std;
 
-/*! Clase Graph. Simula la estructura de un grafo. */
+/*! Estructura PruningKeyHash. Función hash de las entradas del vector de
+    poda. */
+struct PruningKeyHash {
+  size_t operator()(const vector<int> &key) const;
+};
+
+typedef unordered_set<vector<int>, PruningKeyHash> PruningSet;
+
+/*! Clase Graph. Simula la estructura de un grafo: el retículo de
+    generalizaciones de un subconjunto de qids. */
 class Graph {
 private:
-  vector<vector<int>> nodes;
-  GraphData graphData;
+  Lattice lattice;
   vector<int> qids;
-  void generateAllNodes(const vector<int> &node, const vector<int> &nodesMax,
-                        int nsize, int index);
 
 public:
   Graph();
-  Graph(vector<int> nodeMax, vector<int> qids, vector<vector<int>> toPrune,
-        GraphData &treeData);
-  void generateNodesAndEdges(const vector<int> &nodesMax,
-                             vector<vector<int>> toPrune);
-  GraphNode getRoot();
-  set<GraphNode> getLeaves();
+  Graph(const vector<int> &nodesMax, const vector<int> &qids,
+        PruningSet &toPrune);
+  void pruneNodes(PruningSet &toPrune);
+  int size() const;
+  int getRoot() const;
+  vector<int> getLeaves() const;
+  int getHeight(int node) const;
+  int getMaxHeight() const;
+  GraphNode getNode(int node) const;
+  int getPredecessor(int node, int j) const;
+  vector<int> getPruningKey(int node) const;
   vector<int> getQids() const;
-  bool isNodeMarked(GraphNode node);
-  int addGeneralizations(const GraphNode &node, set<GraphNode> &queue);
-  void markGeneralizations(const GraphNode &node);
-  GraphNode getFinalKAnon(map<int, map<string, vector<string>>> gens,
-                          vector<vector<string>> dataset, vector<int> qids);
+  bool isNodeMarked(int node) const;
+  void addGeneralizations(int node, vector<vector<int>> &queue,
+                          vector<bool> &queued) const;
+  void markGeneralizations(int node);
+  GraphNode getFinalKAnon(const map<int, vector<uint32_t>> &leaves,
+                          const map<int, GeneralizationCodes> &codes,
+                          const vector<int> &qids);
 };
 
 #endif
@@ -7,7 +7,8 @@
 
 #include "../utilities/frequencies.h"
 #include "../utilities/hierarchy.h"
-#include "anonymity.h"
+#include "frequencySet.h"
+#include "generalizationCodes.h"
 #include <bits/stdc++.h>
 #include <iostream>
 #include <numeric>
@@ -23,8 +24,6 @@ class GraphNode {
 private:
   int id;
   vector<int> data;
-  bool nodeMark = false;
-  bool kAnon = false;
   string generalizeEntry(string entry, const vector<vector<string>> hierarchy,
                          vector<string> generalizations);
 
@@ -34,24 +33,13 @@ public:
   int getId() const;
   int getData(int i) const;
   vector<int> getData() const;
-  bool isChild(GraphNode node);
-  bool isEqual(const vector<int> &node) const;
-  bool operator<(const GraphNode &node) const;
-  int getSum() const;
-  bool marked() const;
-  void mark();
-  void setKAnon();
-  bool isKAnon() const;
-  bool
-  isAnonymityValid(map<int, vector<vector<string>>> hierarchies,
-                   vector<vector<string>> dataset,
-                   map<int, map<string, vector<string>>> gensMap,
-                   tuple<vector<map<string, int>>, vector<set<string>>> dataMap,
-                   vector<int> qids, vector<int> confAtts, const int K,
-                   const int L, const long double P);
-  vector<int>
-  evaluateFrequency(map<int, map<string, vector<string>>> generalizations,
-                    vector<vector<string>> dataset, vector<int> qids) const;
+  FrequencySet getFrequencySet(const map<int, vector<uint32_t>> &leaves,
+                               const map<int, GeneralizationCodes> &codes,
+                               const TClosenessEvaluator &sensitive,
+                               const vector<int> &qids) const;
+  vector<int> evaluateFrequency(const map<int, vector<uint32_t>> &leaves,
+                                const map<int, GeneralizationCodes> &codes,
+                                const vector<int> &qids) const;
   void print() const;
 };
 
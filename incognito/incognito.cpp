@@ -1,10 +1,97 @@
 #include "incognito.h"
 
+/*! Anonimiza el conjunto de datos con unos parámetros dados, escribe el
+    conjunto de datos anonimizado y calcula las métricas.
+  \param dir directorio del conjunto de datos.
+  \param dataset conjunto de datos.
+  \param headers cabecera del fichero.
+  \param registry registro con las jerarquías y los árboles de los qids.
+  \param qids índices de los atributos qids.
+  \param confAtts índices de los atributos sensibles.
+  \param orderedAtts atributos sensibles con distancia ordenada en
+                     t-closeness.
+  \param weights pesos de cada qid.
+  \param numMetricsQids qids considerados numéricos en las métricas.
+  \param catMetricsQids qids considerados categóricos en las métricas.
+  \param setting parámetros de los modelos de privacidad.
+  \param threads número de hilos (0 para utilizar todos los núcleos).
+  \return resultado y métricas de la ejecución.
+*/
+SweepResult anonymize(const string &dir, const vector<vector<string>> &dataset,
+                      const vector<string> &headers,
+                      const HierarchyRegistry &registry,
+                      const vector<int> &qids,
+                      const vector<int> &confAtts,
+                      const vector<int> &orderedAtts,
+                      const vector<double> &weights,
+                      const vector<int> &numMetricsQids,
+                      const vector<int> &catMetricsQids,
+                      const SweepSetting &setting, const int threads) {
+  SweepResult sweepResult;
+  sweepResult.setting = setting;
+  const int K = setting.K, L = setting.L;
+  const long double T = setting.T;
+
+  // Calcular el tiempo de ejecución
+  auto start = chrono::high_resolution_clock::now();
+  // *********************************
+  // Algoritmo principal
+  auto resTuple =
+      incognito(dataset, registry.getHierarchies(), qids, confAtts, orderedAtts,
+                K, L, T, threads);
+  vector<vector<string>> result = get<0>(resTuple);
+  vector<vector<vector<string>>> clusters = get<1>(resTuple);
+  // *********************************
+  auto stop = chrono::high_resolution_clock::now();
+  auto duration = chrono::duration_cast<chrono::seconds>(stop - start);
+  cout << endl << "===> Incognito Execution Time: ";
+  cout << duration.count() << " seconds" << endl;
+  sweepResult.runSeconds = chrono::duration<double>(stop - start).count();
+
+  cout << "===> Number of clusters: ";
+  cout << clusters.size() << endl;
+  sweepResult.clusters = clusters.size();
+
+  // Escribir conjunto de datos anonimizado
+  writeAnonymizedTable(dir, headers, result, K, L, T);
+
+  // Métricas
+  const auto metricsStart = chrono::steady_clock::now();
+  cout << "===> Analysis: " << endl;
+
+  // GCP
+  // 1. Precalcular NCP para cada atributo qid
+  vector<long double> cncps =
+      calculateNCPS(clusters, weights, qids, numMetricsQids,
+                    registry.getTrees());
+
+  // 2. Calcular GCP
+  sweepResult.gcp = calculateGCP(clusters, dataset.size(), qids, cncps);
+
+  if (K != -1) {
+    // DM
+    sweepResult.dm = calculateDM(clusters, dataset.size(), K);
+
+    // CAvg
+    sweepResult.cavg = calculateCAVG(clusters, dataset.size(), K);
+  }
+
+  // GenILoss
+  sweepResult.genILoss =
+      calculateGenILoss(transpose(result), registry.getTrees(), qids,
+                        catMetricsQids, numMetricsQids, dataset.size());
+  sweepResult.metricsSeconds = elapsedSeconds(metricsStart);
+
+  return sweepResult;
+}
+
 int main(int argc, char **argv) {
+  const bool batch = isBatchMode(argc, argv);
 
-  if (argc != 2) {
+  if (argc != 2 && !batch) {
     cout << "\nInvalid arguments.\n"
-            "Use ./incognito [data directory] [k]\n\n"
+            "Use ./incognito [data directory] "
+            "[--batch configuration file]\n\n"
             "* Make sure your data directory meets the following structure:\n"
             "  (check dataset folder for an example)\n\n"
             " |-- [data directory]\n"
@@ -18,15 +105,22 @@ int main(int argc, char **argv) {
     return -1;
   }
 
-  // Leer parámetros
-  const int nqids = readNumberOfQids();
+  // Leer parámetros, de la entrada estándar o del fichero de configuración
+  SweepConfig config;
   vector<string> qidNames;
   vector<string> confAttNames;
   try {
-    // Leer nombres de qids
-    qidNames = readQidNames(nqids);
-    // Leer atributos sensibles
-    confAttNames = readConfidentialAttNames();
+    if (batch) {
+      config = readSweepConfig(argv[3]);
+      qidNames = config.qidNames;
+      confAttNames = config.confAttNames;
+    } else {
+      const int nqids = readNumberOfQids();
+      // Leer nombres de qids
+      qidNames = readQidNames(nqids);
+      // Leer atributos sensibles
+      confAttNames = readConfidentialAttNames();
+    }
   } catch (const char *e) {
     cout << e << endl;
     return -1;
@@ -35,10 +129,10 @@ int main(int argc, char **argv) {
   // Leer el directorio que contiene el conjunto de datos y las jerarquias
   vector<string> headers;
   vector<int> qids, confAtts;
-  vector<vector<string>> dataset, transposedDataset;
+  vector<vector<string>> dataset;
   map<int, vector<vector<string>>> hierarchiesMap;
-  map<int, vector<vector<string>>> transposedHierarchyMap;
 
+  const auto loadStart = chrono::steady_clock::now();
   try {
     hierarchiesMap =
         readDirectory(fs::path(argv[1]), dataset, headers, qidNames,
@@ -65,93 +159,72 @@ int main(int argc, char **argv) {
            << endl;
       return -1;
     }
-
-    for (const auto &qid : qids) {
-      transposedHierarchyMap[qid] = transpose(hierarchiesMap[qid]);
-    }
-
-    transposedDataset = transpose(dataset);
   } catch (const char *e) {
     cout << e << endl;
     return -1;
   }
 
-  // Leer parámetros vinculados a los modelos de privacidad
-  int K, L;
-  long double T;
-  if(!readParameters(dataset.size(), confAttNames.size(), K, L, T))
-    return -1;
+  // Crear un árbol jerárquico por cada qid categórico. Las jerarquías se
+  // han leído transpuestas
+  const HierarchyRegistry registry(move(hierarchiesMap), qids, true);
+  const double loadSeconds = elapsedSeconds(loadStart);
+
+  vector<double> weights;
+  vector<int> numMetricsQids, catMetricsQids, orderedAtts;
+  tuple<vector<int>, vector<int>> metricsQids;
+  if (batch) {
+    try {
+      for (const SweepSetting &setting : config.settings)
+        checkSweepSetting(setting, dataset.size(), confAttNames.size());
+      weights = sweepWeights(config);
+      orderedAtts = sweepOrderedAtts(config, confAtts, headers);
+      metricsQids = sweepMetricsQids(config, {}, qids, headers);
+    } catch (const char *e) {
+      cout << e << endl;
+      return -1;
+    }
+  } else {
+    // Leer parámetros vinculados a los modelos de privacidad
+    SweepSetting setting;
+    if (!readParameters(dataset.size(), confAttNames.size(), setting.K,
+                        setting.L, setting.T))
+      return -1;
+    config.settings.emplace_back(setting);
 
-  // Leer pesos asignados a cada qid
-  vector<double> weights = readWeights(nqids, qidNames);
-  // Leer tipos de qids (importante considerar los atributos numéricos como tales)
-  vector<int> numMetricsQids, catMetricsQids;
-  tuple<vector<int>, vector<int>> metricsQids =
-      readMetricsQids({}, qids, headers);
+    // Leer pesos asignados a cada qid
+    weights = readWeights(qidNames.size(), qidNames);
+    // Leer tipos de qids (importante considerar los atributos numéricos como
+    // tales)
+    metricsQids = readMetricsQids({}, qids, headers);
+  }
   numMetricsQids = get<0>(metricsQids);
   catMetricsQids = get<1>(metricsQids);
 
-  // Calcular el tiempo de ejecución
-  auto start = chrono::high_resolution_clock::now();
-  // *********************************
-  // Algoritmo principal
-  auto resTuple = incognito(dataset, hierarchiesMap, qids, confAtts, K, L, T);
-  vector<vector<string>> result = get<0>(resTuple);
-  vector<vector<vector<string>>> clusters = get<1>(resTuple);
-  // *********************************
-  auto stop = chrono::high_resolution_clock::now();
-  auto duration = chrono::duration_cast<chrono::seconds>(stop - start);
-  cout << endl << "===> Incognito Execution Time: ";
-  cout << duration.count() << " seconds" << endl;
-
-  cout << "===> Number of clusters: ";
-  cout << clusters.size() << endl;
-
-  // Escribir conjunto de datos anonimizado
-  writeAnonymizedTable(fs::path(argv[1]), headers, result, K, L, T);
-
-  // Crear un árbol jerárquico por cada qid categórico
-  vector<Tree> trees;
-  for (const int &val : qids) {
-    trees.emplace_back(Tree(transposedHierarchyMap[val]));
-  }
-
-  // Métricas
-  cout << "===> Analysis: " << endl;
-  // Convertir árboles jerárquicos en un mapa de datos
-  map<int, Tree> treeMap;
-  for (size_t i = 0; i < qids.size(); i++) {
-    treeMap[qids[i]] = trees[i];
-  }
-
-  // GCP
+  ofstream sweepFile;
+  string sweepName;
   try {
-    // 1. Precalcular NCP para cada atributo qid
-    vector<long double> cncps =
-        calculateNCPS(clusters, weights, qids, numMetricsQids, treeMap);
+    if (batch) {
+      sweepName = sweepOutputName(config, argv[1], "incognito");
+      sweepFile.open(sweepName);
+      writeSweepHeader(sweepFile);
+    }
 
-    // 2. Calcular GCP
-    calculateGCP(clusters, dataset.size(), qids, cncps);
+    for (const SweepSetting &setting : config.settings) {
+      SweepResult result =
+          anonymize(argv[1], dataset, headers, registry, qids, confAtts,
+                    orderedAtts, weights, numMetricsQids, catMetricsQids,
+                    setting, config.threads);
+      if (batch)
+        writeSweepRow(sweepFile, "incognito", loadSeconds, result);
+    }
   } catch (const char *e) {
     cout << e << endl;
     return -1;
   }
 
-  if (K != -1) {
-    // DM
-    calculateDM(clusters, dataset.size(), K);
-
-    // CAvg
-    calculateCAVG(clusters, dataset.size(), K);
-  }
-
-  // GenILoss
-  try {
-    calculateGenILoss(transpose(result), treeMap, qids, catMetricsQids,
-                      numMetricsQids, dataset.size());
-  } catch (const char *e) {
-    cout << e << endl;
-    return -1;
+  if (batch) {
+    cout << endl << "===> Sweep metrics written to file: " << endl;
+    cout << "\t* " + sweepName << endl;
   }
 
   return 0;
@@ -8,8 +8,10 @@
 #include "../utilities/analysis.h"
 #include "../utilities/frequencies.h"
 #include "../utilities/hierarchy.h"
+#include "../utilities/hierarchyRegistry.h"
 #include "../utilities/input.h"
 #include "../utilities/metrics.h"
+#include "../utilities/sweep.h"
 #include "../utilities/tree.h"
 #include "../utilities/writeData.h"
 #include "evaluate.h"
@@ -18,6 +20,16 @@
 
 using namespace std;
 
+SweepResult anonymize(const string &dir, const vector<vector<string>> &dataset,
+                      const vector<string> &headers,
+                      const HierarchyRegistry &registry,
+                      const vector<int> &qids,
+                      const vector<int> &confAtts,
+                      const vector<int> &orderedAtts,
+                      const vector<double> &weights,
+                      const vector<int> &numMetricsQids,
+                      const vector<int> &catMetricsQids,
+                      const SweepSetting &setting, const int threads);
 int main(int argc, char **argv);
 
 #endif
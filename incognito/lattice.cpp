@@ -0,0 +1,179 @@
+/*! \file lattice.cpp
+    \brief Fichero que contiene la clase Lattice, retículo de
+           generalizaciones de incognito.
+*/
+
+#include "lattice.h"
+
+// Constructor vacio de la clase Lattice.
+Lattice::Lattice() { this->numNodes = 0; }
+
+/*! Constructor de la clase Lattice. Todos los nodos se encuentran en el
+    retículo, sin marcar.
+  \param maxLevels nivel de generalización máximo de cada qid.
+*/
+Lattice::Lattice(const vector<int> &maxLevels) {
+  this->maxLevels = maxLevels;
+  this->strides.resize(maxLevels.size());
+
+  int stride = 1;
+  for (size_t i = 0; i < maxLevels.size(); i++) {
+    this->strides[i] = stride;
+    stride *= maxLevels[i] + 1;
+  }
+  this->numNodes = stride;
+
+  this->pruned.assign(this->numNodes, false);
+  this->nodeMarks.assign(this->numNodes, false);
+  this->kAnon.assign(this->numNodes, false);
+}
+
+/*! Devuelve el número de nodos del retículo, incluidos los podados.
+  \return número de nodos.
+*/
+int Lattice::size() const { return this->numNodes; }
+
+/*! Devuelve la altura del nodo más general.
+  \return altura máxima.
+*/
+int Lattice::getMaxHeight() const { return getHeight(getTop()); }
+
+/*! Calcula el índice de un nodo a partir de sus niveles de generalización.
+  \param levels nivel de generalización de cada qid.
+  \return índice del nodo.
+*/
+int Lattice::encode(const vector<int> &levels) const {
+  int node = 0;
+  for (size_t i = 0; i < levels.size(); i++)
+    node += levels[i] * this->strides[i];
+  return node;
+}
+
+/*! Calcula los niveles de generalización de un nodo.
+  \param node índice del nodo.
+  \return nivel de generalización de cada qid.
+*/
+vector<int> Lattice::decode(int node) const {
+  vector<int> levels(this->maxLevels.size());
+  for (size_t i = 0; i < levels.size(); i++)
+    levels[i] = getLevel(node, i);
+  return levels;
+}
+
+/*! Devuelve el nivel de generalización de un qid en un nodo.
+  \param node índice del nodo.
+  \param i posición del qid.
+  \return nivel de generalización.
+*/
+int Lattice::getLevel(int node, int i) const {
+  return node / this->strides[i] % (this->maxLevels[i] + 1);
+}
+
+/*! Devuelve la altura de un nodo, la suma de sus niveles de generalización.
+  \param node índice del nodo.
+  \return altura del nodo.
+*/
+int Lattice::getHeight(int node) const {
+  int height = 0;
+  for (size_t i = 0; i < this->maxLevels.size(); i++)
+    height += getLevel(node, i);
+  return height;
+}
+
+/*! Devuelve el nodo más general, el que generaliza cada qid a su nivel
+    máximo.
+  \return índice del nodo.
+*/
+int Lattice::getTop() const { return this->numNodes - 1; }
+
+/*! Comprueba si un nodo se encuentra en el retículo (no ha sido podado).
+  \param node índice del nodo.
+  \return 1 si se encuentra en el retículo, 0 si no es así.
+*/
+bool Lattice::contains(int node) const { return !this->pruned[node]; }
+
+/*! Poda un nodo del retículo.
+  \param node índice del nodo.
+*/
+void Lattice::prune(int node) { this->pruned[node] = true; }
+
+/*! Devuelve los sucesores (generalizaciones directas) de un nodo que se
+    encuentran en el retículo: los que incrementan en uno el nivel de un
+    único qid.
+  \param node índice del nodo.
+  \return lista de sucesores.
+*/
+vector<int> Lattice::getSuccessors(int node) const {
+  vector<int> successors;
+  for (size_t i = 0; i < this->maxLevels.size(); i++) {
+    const int successor = node + this->strides[i];
+    if (getLevel(node, i) < this->maxLevels[i] && contains(successor))
+      successors.emplace_back(successor);
+  }
+  return successors;
+}
+
+/*! Devuelve el predecesor de un nodo que decrementa en uno el nivel de un
+    qid.
+  \param node índice del nodo.
+  \param i posición del qid.
+  \return índice del predecesor, o -1 si el qid se encuentra en su nivel
+          mínimo o el predecesor ha sido podado.
+*/
+int Lattice::getPredecessor(int node, int i) const {
+  const int predecessor = node - this->strides[i];
+  if (getLevel(node, i) == 0 || !contains(predecessor))
+    return -1;
+  return predecessor;
+}
+
+/*! Devuelve los predecesores (especializaciones directas) de un nodo que se
+    encuentran en el retículo: los que decrementan en uno el nivel de un
+    único qid.
+  \param node índice del nodo.
+  \return lista de predecesores.
+*/
+vector<int> Lattice::getPredecessors(int node) const {
+  vector<int> predecessors;
+  for (size_t i = 0; i < this->maxLevels.size(); i++) {
+    const int predecessor = getPredecessor(node, i);
+    if (predecessor != -1)
+      predecessors.emplace_back(predecessor);
+  }
+  return predecessors;
+}
+
+/*! Devuelve los nodos del retículo sin predecesores, de los que parte el
+    recorrido de incognito.
+  \return lista de nodos.
+*/
+vector<int> Lattice::getBottoms() const {
+  vector<int> bottoms;
+  for (int node = 0; node < this->numNodes; node++) {
+    if (contains(node) && getPredecessors(node).empty())
+      bottoms.emplace_back(node);
+  }
+  return bottoms;
+}
+
+/*! Comprueba si un nodo se encuentra marcado.
+  \param node índice del nodo.
+  \return 1 si se encuentra marcado, 0 si no es así.
+*/
+bool Lattice::isMarked(int node) const { return this->nodeMarks[node]; }
+
+/*! Marca un nodo.
+  \param node índice del nodo.
+*/
+void Lattice::mark(int node) { this->nodeMarks[node] = true; }
+
+/*! Comprueba si un nodo cumple con los modelos de privacidad.
+  \param node índice del nodo.
+  \return 1 si cumple con los modelos de privacidad, 0 si no es así.
+*/
+bool Lattice::isKAnon(int node) const { return this->kAnon[node]; }
+
+/*! Establece que un nodo cumple con los modelos de privacidad.
+  \param node índice del nodo.
+*/
+void Lattice::setKAnon(int node) { this->kAnon[node] = true; }
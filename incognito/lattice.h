@@ -0,0 +1,50 @@
+/*! \file lattice.h
+    \brief Fichero de cabecera del archivo lattice.cpp.
+*/
+
+#ifndef _LATTICE_H
+#define _LATTICE_H
+
+#include <vector>
+
+using namespace std;
+
+/*! Clase Lattice. Retículo de generalizaciones de un subconjunto de qids.
+    Cada nodo es un índice en base mixta sobre el nivel de generalización de
+    cada qid (el primero es el menos significativo), por lo que sus sucesores
+    y predecesores se calculan aritméticamente. Los nodos podados, marcados
+    y que cumplen los modelos de privacidad se guardan en mapas de bits.
+*/
+class Lattice {
+private:
+  vector<int> maxLevels;
+  vector<int> strides;
+  int numNodes;
+  vector<bool> pruned;
+  vector<bool> nodeMarks;
+  vector<bool> kAnon;
+
+public:
+  // Constructors
+  Lattice();
+  Lattice(const vector<int> &maxLevels);
+  int size() const;
+  int getMaxHeight() const;
+  int encode(const vector<int> &levels) const;
+  vector<int> decode(int node) const;
+  int getLevel(int node, int i) const;
+  int getHeight(int node) const;
+  int getTop() const;
+  bool contains(int node) const;
+  void prune(int node);
+  vector<int> getSuccessors(int node) const;
+  int getPredecessor(int node, int i) const;
+  vector<int> getPredecessors(int node) const;
+  vector<int> getBottoms() const;
+  bool isMarked(int node) const;
+  void mark(int node);
+  bool isKAnon(int node) const;
+  void setKAnon(int node);
+};
+
+#endif
@@ -184,6 +184,29 @@ vector<vector<vector<string>>> generalize(vector<Group> groups,
   return clusters;
 }
 
+//! Lee los registros numéricos de un fragmento del fichero
+/*!
+  \param chunk fragmento del fichero, alineado a línea.
+  \param values valores numéricos de cada registro del fragmento.
+  \return false si se encontró un valor no numérico.
+*/
+bool parseRecords(string_view chunk, vector<vector<double>> &values) {
+  string_view line;
+  vector<string_view> cells;
+  try {
+    while (nextLine(chunk, line)) {
+      splitLine(line, ';', cells);
+      vector<double> record;
+      for (const string_view &val : cells)
+        record.push_back(stod(string(val)));
+      values.push_back(move(record));
+    }
+  } catch (const exception &e) {
+    return false;
+  }
+  return true;
+}
+
 //! Realiza la lectura del conjunto de datos
 /*!
   \param file fichero en el que esta contenido el conjunto de datos.
@@ -195,51 +218,52 @@ vector<vector<vector<string>>> generalize(vector<Group> groups,
 vector<Record> preprocessing(string file, vector<string> &headers,
                              vector<string> qidNames, vector<int> &qids) {
   // Leer fichero CSV
-  ifstream input{file};
-  if (!input.is_open()) {
-    throw "Error reading file";
+  MappedFile input(file);
+  string_view content(input.begin(), input.size());
+
+  // Headers && Qids
+  string_view headersAux;
+  vector<string_view> cells;
+  nextLine(content, headersAux);
+  splitLine(headersAux, ';', cells);
+  for (const string_view &tmp : cells)
+    headers.emplace_back(tmp);
+  headers.back().pop_back();
+
+  // ïndices de los qids
+  for (size_t i = 0; i < qidNames.size(); i++) {
+    auto it = find(headers.begin(), headers.end(), qidNames[i]);
+    if (it != headers.end())
+      qids.emplace_back(it - headers.begin());
+    else if (headers.back() == qidNames[i])
+      qids.emplace_back(headers.size() - 1);
   }
 
-  // Parse fichero CSV
+  // Registros: cada hilo lee un fragmento del fichero
+  const vector<string_view> chunks =
+      splitChunks(content.data(), content.data() + content.size(),
+                  parseThreads(content.size()));
+  vector<vector<vector<double>>> chunkValues(chunks.size());
+  vector<char> completed(chunks.size(), true);
+  vector<thread> workers;
+  for (size_t i = 0; i < chunks.size(); i++)
+    workers.emplace_back([&, i]() {
+      completed[i] = parseRecords(chunks[i], chunkValues[i]);
+    });
+  for (thread &worker : workers)
+    worker.join();
+
+  // Unir los fragmentos en el orden del fichero. La lectura se detiene en
+  // el primer valor no numérico
   vector<Record> values;
   int index = 0;
-  string line, headersAux;
-  try {
-    // Headers && Qids
-    getline(input, headersAux);
-    string tmp;
-    stringstream ss(headersAux);
-    while (getline(ss, tmp, ';')) {
-      headers.push_back(tmp);
-    }
-    headers.back().pop_back();
-
-    // ïndices de los qids
-    for (size_t i = 0; i < qidNames.size(); i++) {
-      auto it = find(headers.begin(), headers.end(), qidNames[i]);
-      if (it != headers.end())
-        qids.emplace_back(it - headers.begin());
-      else if (headers.back() == qidNames[i])
-        qids.emplace_back(headers.size() - 1);
-    }
-
-    // Registros
-    for (; getline(input, line);) {
-      Record record = Record(index);
-      istringstream strm(move(line));
-
-      for (string val; getline(strm, val, ';');) {
-        record.pushBackValue(stod(val));
-      }
-      values.push_back(move(record));
-      index++;
-    }
-  } catch (const exception &e) {
-    input.close();
-    return values;
+  for (size_t i = 0; i < chunks.size(); i++) {
+    for (vector<double> &record : chunkValues[i])
+      values.emplace_back(index++, move(record));
+    if (!completed[i])
+      break;
   }
 
-  input.close();
   return values;
 }
 
@@ -19,6 +19,8 @@
 #include <fstream>    // ofstream
 #include <iostream>   // cout
 #include <string>
+#include <string_view>
+#include <thread>
 #include <tuple>
 #include <vector>
 
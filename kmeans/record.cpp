@@ -11,6 +11,16 @@
 */
 Record::Record(int ridx) { rindex = ridx; }
 
+//! Constructor de la clase Record a partir de sus valores
+/*!
+  \param ridx índice del registro.
+  \param values valores numéricos del registro.
+*/
+Record::Record(int ridx, vector<double> values) {
+  rindex = ridx;
+  this->values = move(values);
+}
+
 //! Inserta un elemento en el registro.
 /*!
   \param value valor numérico.
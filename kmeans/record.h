@@ -25,6 +25,7 @@ private:
 
 public:
   Record(int ridx);
+  Record(int ridx, vector<double> values);
   void pushBackValue(double value);
   void setGroup(int gidx);
   int getGindex() const;
@@ -21,21 +21,20 @@ int randomRecord(vector<vector<string>> records) {
   \param record registro.
   \param index índice del registro record.
   \param records lista de registros.
-  \param hierarchies mapa de jerarquias.
+  \param registry registro con las jerarquías y los árboles jerárquicos.
   \param numQids lista de índices de atributos numéricos.
   \param catQids lista de índices de atributos categóricos.
   \return índice del registro seleccionado.
 */
 int furthestRecord(vector<string> record, int index,
                    vector<vector<string>> records,
-                   map<int, vector<vector<string>>> hierarchies,
-                   map<int, Tree> trees, vector<int> numQids,
+                   const HierarchyRegistry &registry, vector<int> numQids,
                    vector<int> catQids) {
   long double furthestDiff = -1;
   int furthestIdx = -1;
 
   // Precalcular valores necesarios a través de la clase Info
-  Info info(records, hierarchies, trees, numQids, catQids);
+  Info info(records, registry, numQids, catQids);
 
   // Comparar el registro principal con todos los demás
   for (size_t idx = 0; idx < records.size(); idx++) {
@@ -77,7 +76,8 @@ long double numDistance(long double v1, long double v2,
   \param attIndex índice del atributo categórico.
   \return valor de la distancia calculada.
 */
-long double catDistance(string &v1, string &v2, Info info, int attIndex) {
+long double catDistance(const string &v1, const string &v2, const Info &info,
+                        int attIndex) {
 
   return info.getSubTreeHeight(v1, v2, attIndex) / info.getTreeHeight(attIndex);
 
@@ -91,40 +91,31 @@ long double catDistance(string &v1, string &v2, Info info, int attIndex) {
               manipular el árbol jerárquico.
   \return suma de las distancias calculadas.
 */
-long double distance(vector<string> &r1, vector<string> &r2, Info info) {
+long double distance(const vector<string> &r1, const vector<string> &r2,
+                     const Info &info) {
   long double numSum = 0.0, catSum = 0.0;
-  string v1, v2;
   // Atributos numéricos
-  for (const auto &idx : info.getNumQids()) {
-    v1 = r1[idx];
-    v2 = r2[idx];
-
-    numSum += numDistance(stold(v1), stold(v2), info.getMaxDomSize(idx));
-  }
+  for (const auto &idx : info.getNumQids())
+    numSum += numDistance(stold(r1[idx]), stold(r2[idx]),
+                          info.getMaxDomSize(idx));
 
   // Atributos categóricos
-  for (const auto &idx : info.getCatQids()) {
-    v1 = r1[idx];
-    v2 = r2[idx];
-
-    catSum += catDistance(v1, v2, info, idx);
-  }
+  for (const auto &idx : info.getCatQids())
+    catSum += catDistance(r1[idx], r2[idx], info, idx);
 
   return numSum + catSum;
 }
 
 /*! Cálcula la pérdida de información en función de la métrica IL.
   \param records lista de registros.
-  \param hierarchies mapa de jerarquias.
-  \param trees árboles jerárquicos.
+  \param registry registro con las jerarquías y los árboles jerárquicos.
   \param numQids lista de índices de atributos numéricos.
   \param catQids lista de índices de atributos categóricos.
   \return valor calculado de la métrica IL.
 */
 long double informationLoss(vector<vector<string>> records,
-                            map<int, vector<vector<string>>> hierarchies,
-                            map<int, Tree> trees, vector<int> numQids,
-                            vector<int> catQids) {
+                            const HierarchyRegistry &registry,
+                            vector<int> numQids, vector<int> catQids) {
   int e = records.size();
   vector<long double> numValues, catValues;
 
@@ -150,7 +141,7 @@ long double informationLoss(vector<vector<string>> records,
   }
 
   // Atributos categóricos
-  Info info(records, hierarchies, trees, vector<int>{}, catQids);
+  Info info(records, registry, vector<int>{}, catQids);
 
   for (const int &idx : catQids) {
     catValues.emplace_back(info.lowestCommonAncestor(idx) /
@@ -168,8 +159,7 @@ long double informationLoss(vector<vector<string>> records,
     añadirse a una clase de equivalencia.
   \param records lista de registros.
   \param cluster clase de equivalencia.
-  \param hierarchies mapa de jerarquias.
-  \param trees árboles jerárquicos.
+  \param registry registro con las jerarquías y los árboles jerárquicos.
   \param numQids lista de índices de atributos numéricos.
   \param catQids lista de índices de atributos categóricos.
   \param confAtt índice del atributo sensible.
@@ -181,8 +171,7 @@ long double informationLoss(vector<vector<string>> records,
 */
 int findBestRecord(vector<vector<string>> records,
                    vector<vector<string>> cluster,
-                   map<int, vector<vector<string>>> hierarchies,
-                   map<int, Tree> trees, vector<int> numQids,
+                   const HierarchyRegistry &registry, vector<int> numQids,
                    vector<int> catQids, int confAtt, const int L,
                    vector<string> sensitiveValues, const int diversityPenalty,
                    const int diversity) {
@@ -195,8 +184,8 @@ int findBestRecord(vector<vector<string>> records,
     aux.emplace_back(records[i]);
 
     long double auxDiff =
-        informationLoss(aux, hierarchies, trees, numQids, catQids) -
-        informationLoss(cluster, hierarchies, trees, numQids, catQids);
+        informationLoss(aux, registry, numQids, catQids) -
+        informationLoss(cluster, registry, numQids, catQids);
     // K-Anonimidad
     diff = auxDiff;
     if (L != -1) {
@@ -232,16 +221,14 @@ int findBestRecord(vector<vector<string>> records,
     al añadirle un registro.
   \param clusters clases de equivalencia.
   \param records lista de registros.
-  \param hierarchies mapa de jerarquias.
-  \param trees árboles jerárquicos.
+  \param registry registro con las jerarquías y los árboles jerárquicos.
   \param numQids lista de índices de atributos numéricos.
   \param catQids lista de índices de atributos categóricos.
   \return índice de la clase elegida.
 */
 int findBestCluster(map<int, vector<vector<string>>> clusters,
                     vector<string> record,
-                    map<int, vector<vector<string>>> hierarchies,
-                    map<int, Tree> trees, vector<int> numQids,
+                    const HierarchyRegistry &registry, vector<int> numQids,
                     vector<int> catQids) {
   long double min = -1, diff;
   int best;
@@ -251,8 +238,8 @@ int findBestCluster(map<int, vector<vector<string>>> clusters,
     aux = clusters[i];
     aux.emplace_back(record);
 
-    diff = informationLoss(aux, hierarchies, trees, numQids, catQids) -
-           informationLoss(clusters[i], hierarchies, trees, numQids, catQids);
+    diff = informationLoss(aux, registry, numQids, catQids) -
+           informationLoss(clusters[i], registry, numQids, catQids);
     if (diff < min || min == -1) {
       min = diff;
       best = i;
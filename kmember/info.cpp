@@ -6,17 +6,15 @@
 
 /*! Constructor de la clase Info.
   \param records lista de registros.
-  \param hierarchies mapa de jerarquias.
+  \param registry registro con las jerarquías y los árboles jerárquicos.
   \param numQids lista de índices de atributos numéricos.
   \param catQids lista de índices de atributos categóricos.
 */
-Info::Info(vector<vector<string>> records,
-           map<int, vector<vector<string>>> hierarchies, map<int, Tree> trees,
+Info::Info(vector<vector<string>> records, const HierarchyRegistry &registry,
            vector<int> numQids, vector<int> catQids) {
   this->records = records;
   this->attsValues = transpose(records);
-  this->hierarchies = hierarchies;
-  this->trees = trees;
+  this->registry = &registry;
   this->numQids = numQids;
   this->catQids = catQids;
 
@@ -45,12 +43,12 @@ int Info::valueType(int qid) {
 /*! Devuelve los atributos qid numéricos.
   \return lista ded atributos qids numéricos.
 */
-vector<int> Info::getNumQids() { return this->numQids; }
+const vector<int> &Info::getNumQids() const { return this->numQids; }
 
 /*! Devuelve los atributos qid categóricos.
   \return lista de atributos qids categóricos.
 */
-vector<int> Info::getCatQids() { return this->catQids; }
+const vector<int> &Info::getCatQids() const { return this->catQids; }
 
 /*! Cálcula las alturas de los árboles jerárquicos.
 */
@@ -59,7 +57,7 @@ void Info::calculateHeights() {
 
   for (const auto &idx : this->catQids) {
     int height = 0;
-    for (const auto &gens : this->hierarchies[idx]) {
+    for (const auto &gens : this->registry->getHierarchy(idx)) {
       aux = gens.size();
       if (aux > height)
         height = aux;
@@ -97,13 +95,17 @@ void Info::calculateMaxDomSizes() {
   \param index índice del qid categórico.
   \return altura del árbol.
 */
-int Info::getTreeHeight(int index) { return trees[index].getHeight(); }
+int Info::getTreeHeight(int index) const {
+  return findTree(this->registry->getTrees(), index).getHeight();
+}
 
 /*! Devuelve el rango de un atributo numérico.
   \param index índice del qid numérico.
   \return rango máximo de valores.
 */
-long double Info::getMaxDomSize(int index) { return this->maxDomSizes[index]; }
+long double Info::getMaxDomSize(int index) const {
+  return this->maxDomSizes.at(index);
+}
 
 /*! Devuelve una lista de todos los registros.
   \return lista de registros.
@@ -114,8 +116,8 @@ vector<vector<string>> Info::getRecords() { return this->records; }
   \param index índice del qid categórico.
   \return altura del árbol.
 */
-map<int, vector<vector<string>>> Info::getHierarchies() {
-  return this->hierarchies;
+const map<int, vector<vector<string>>> &Info::getHierarchies() const {
+  return this->registry->getHierarchies();
 }
 
 /*! Devuelve la altura del subárbol definido por v1 y v2.
@@ -124,17 +126,17 @@ map<int, vector<vector<string>>> Info::getHierarchies() {
   \param index índice del qid categórico.
   \return altura del subárbol.
 */
-int Info::getSubTreeHeight(string v1, string v2, int index) {
-  string ancestor =
-      trees[index].getLowestCommonAncestor(vector<string>({v1, v2})).value;
-  return trees[index].getHeight(ancestor);
+int Info::getSubTreeHeight(const string &v1, const string &v2,
+                           int index) const {
+  const Tree &tree = findTree(this->registry->getTrees(), index);
+  return tree.getHeight(tree.getLowestCommonAncestor(v1, v2));
 }
 
 /*! Devuelve el ancestro común mínimo (a menor profundidad) de todos los registros.
   \param index índice del qid categórico.
   \return valor del ancestro común.
 */
-int Info::lowestCommonAncestor(int index) {
+int Info::lowestCommonAncestor(int index) const {
 
   set<string> valueSet;
   vector<int> indexes;
@@ -144,7 +146,8 @@ int Info::lowestCommonAncestor(int index) {
   }
 
   vector<string> values(valueSet.begin(), valueSet.end());
-  string ancestor = trees[index].getLowestCommonAncestor(values).value;
+  const Tree &tree = findTree(this->registry->getTrees(), index);
+  string ancestor = tree.getLowestCommonAncestor(values).value;
 
-  return trees[index].getHeight(ancestor);
+  return tree.getHeight(ancestor);
 }
@@ -6,20 +6,21 @@
 #define _INFO_H
 
 #include "../utilities/hierarchy.h"
+#include "../utilities/hierarchyRegistry.h"
 #include "../utilities/tree.h"
 #include <iostream>
 #include <vector>
 
 /*! Clase Info. Su función es contener todas las estructuras y funciones
     necesarias para manipular el árbol jerárquico de la forma que necesita
-    k-member.
+    k-member. Las jerarquías y los árboles se consultan en el registro
+    compartido, sin copiarse en cada instancia.
 */
 class Info {
 private:
   vector<vector<string>> records;
   vector<vector<string>> attsValues;
-  map<int, vector<vector<string>>> hierarchies;
-  map<int, Tree> trees;
+  const HierarchyRegistry *registry;
   vector<int> numQids, catQids;
   map<int, int> treeHeights;
   map<int, long double> maxDomSizes;
@@ -28,18 +29,17 @@ private:
   void calculateMaxDomSizes();
 
 public:
-  Info(vector<vector<string>> records,
-       map<int, vector<vector<string>>> hierarchies, map<int, Tree> trees,
+  Info(vector<vector<string>> records, const HierarchyRegistry &registry,
        vector<int> numQids, vector<int> catQids);
-  vector<int> getNumQids();
-  vector<int> getCatQids();
+  const vector<int> &getNumQids() const;
+  const vector<int> &getCatQids() const;
   int valueType(int qid);
   vector<vector<string>> getRecords();
-  map<int, vector<vector<string>>> getHierarchies();
-  int getTreeHeight(int index);
-  long double getMaxDomSize(int index);
-  int getSubTreeHeight(string v1, string v2, int index);
-  int lowestCommonAncestor(int index);
+  const map<int, vector<vector<string>>> &getHierarchies() const;
+  int getTreeHeight(int index) const;
+  long double getMaxDomSize(int index) const;
+  int getSubTreeHeight(const string &v1, const string &v2, int index) const;
+  int lowestCommonAncestor(int index) const;
 };
 
 #endif
@@ -14,7 +14,7 @@
   \return valor del ancestro común.
 */
 map<int, vector<vector<string>>>
-generalize(map<int, vector<vector<string>>> data, map<int, Tree> trees,
+generalize(map<int, vector<vector<string>>> data, const map<int, Tree> &trees,
            vector<int> numQids, vector<int> catQids, int clusters) {
   // Generalizar valores en función de las clases de equivalencia (global recoding)
   for (int i = 0; i < clusters; i++) {
@@ -24,7 +24,7 @@ generalize(map<int, vector<vector<string>>> data, map<int, Tree> trees,
     // Generalizar atributos qids categóricos
     for (const auto &qid : catQids) {
       // Generalizar valores utilizando su ancestro común
-      string gen = trees[qid].getLowestCommonAncestor(matrix[qid]).value;
+      string gen = trees.at(qid).getLowestCommonAncestor(matrix[qid]).value;
       for (size_t idx = 0; idx < cluster.size(); idx++)
         data[i][idx][qid] = gen;
     }
@@ -48,7 +48,7 @@ generalize(map<int, vector<vector<string>>> data, map<int, Tree> trees,
 
 /*! Rutina principal del algoritmo k-member.
   \param dataset conjunto de datos.
-  \param hierarchies mapa de jerarquias.
+  \param registry registro con las jerarquías y los árboles jerárquicos.
   \param numQids lista de índices de atributos numéricos.
   \param catQids lista de índices de atributos categóricos.
   \param confAtts lista de índices de atributos sensibles.
@@ -62,22 +62,16 @@ generalize(map<int, vector<vector<string>>> data, map<int, Tree> trees,
 */
 map<int, vector<vector<string>>>
 evaluate(vector<vector<string>> dataset,
-         map<int, vector<vector<string>>> hierarchies, vector<int> numQids,
+         const HierarchyRegistry &registry, vector<int> numQids,
          vector<int> catQids, const int confAtt, const int K, const int L,
          const vector<string> sensitiveValues, const int diversityPenalty,
          const int diversity, int &count) {
-  // Crea un árbol jerárquico para cada atributo qid
-  map<int, Tree> trees;
-  for (const int &i : catQids) {
-    trees[i] = Tree(hierarchies[i]);
-  }
-
   // Algoritmo principal
   map<int, vector<vector<string>>> res;
   if (dataset.size() <= (size_t)K) {
     res[0] = dataset;
     count = 1;
-    return generalize(res, trees, numQids, catQids, count);
+    return generalize(res, registry.getTrees(), numQids, catQids, count);
   }
 
   vector<vector<string>> S = dataset;
@@ -87,12 +81,12 @@ evaluate(vector<vector<string>> dataset,
 
   // 1º bucle
   while ((int)S.size() >= K) {
-    r = furthestRecord(aux, r, S, hierarchies, trees, numQids, catQids);
+    r = furthestRecord(aux, r, S, registry, numQids, catQids);
     vector<vector<string>> c(1, S[r]);
     S.erase(S.begin() + r);
 
     while ((int)c.size() < K) {
-      r = findBestRecord(S, c, hierarchies, trees, numQids, catQids, confAtt, L,
+      r = findBestRecord(S, c, registry, numQids, catQids, confAtt, L,
                          sensitiveValues, diversityPenalty, diversity);
 
       c.emplace_back(S[r]);
@@ -108,12 +102,12 @@ evaluate(vector<vector<string>> dataset,
   int idx;
   while (S.size() > 0) {
     r = randomRecord(S);
-    idx = findBestCluster(res, S[r], hierarchies, trees, numQids, catQids);
+    idx = findBestCluster(res, S[r], registry, numQids, catQids);
     res[idx].emplace_back(S[r]);
     S.erase(S.begin() + r);
   }
 
-  return generalize(res, trees, numQids, catQids, count);
+  return generalize(res, registry.getTrees(), numQids, catQids, count);
 }
 
 int main(int argc, char **argv) {
@@ -189,6 +183,9 @@ int main(int argc, char **argv) {
     return -1;
   }
 
+  // Crear un árbol jerárquico para cada atributo qid categórico
+  const HierarchyRegistry registry(move(hierarchiesMap), catQids);
+
   // Leer el atributo sensible
   int confAtt = -1;
   if (confAttNames.size() != 0)
@@ -220,7 +217,7 @@ int main(int argc, char **argv) {
 
     // Leer valores sensibles para SDM
     if (diversity == 1) {
-      vector<string> values = transpose(hierarchiesMap[confAtt])[0];
+      vector<string> values = transpose(registry.getHierarchy(confAtt))[0];
       sensitiveValues = readSensitiveValues(values);
     }
   }
@@ -240,7 +237,7 @@ int main(int argc, char **argv) {
   // Algoritmo principal
   int count = 0;
   map<int, vector<vector<string>>> res =
-      evaluate(dataset, hierarchiesMap, numQids, catQids, confAtt, K, L,
+      evaluate(dataset, registry, numQids, catQids, confAtt, K, L,
                sensitiveValues, diversityPenalty, diversity, count);
   // *********************************
   auto stop = chrono::high_resolution_clock::now();
@@ -268,17 +265,13 @@ int main(int argc, char **argv) {
   vector<vector<vector<string>>> clusters;
   for (const auto &[k, cluster] : res)
     clusters.emplace_back(cluster);
-  // Convertir árboles jerárquicos en un mapa de datos
-  map<int, Tree> trees;
-  for (const int &i : catQids) {
-    trees[i] = Tree(hierarchiesMap[i]);
-  }
 
   // GCP
   try {
     // 1. Precalcular NCP para cada atributo qid
     vector<long double> cncps =
-        calculateNCPS(clusters, weights, allQids, numMetricsQids, trees);
+        calculateNCPS(clusters, weights, allQids, numMetricsQids,
+                      registry.getTrees());
     // 2. Calcular GCP
     calculateGCP(clusters, dataset.size(), allQids, cncps);
   } catch (const char *e) {
@@ -296,8 +289,8 @@ int main(int argc, char **argv) {
 
   // GenILoss
   try {
-    calculateGenILoss(transpose(result), trees, allQids, catMetricsQids,
-                      numMetricsQids, dataset.size());
+    calculateGenILoss(transpose(result), registry.getTrees(), allQids,
+                      catMetricsQids, numMetricsQids, dataset.size());
   } catch (const char *e) {
     cout << e << endl;
     return -1;
@@ -7,6 +7,7 @@
 
 #include "../utilities/analysis.h"
 #include "../utilities/hierarchy.h"
+#include "../utilities/hierarchyRegistry.h"
 #include "../utilities/input.h"
 #include "../utilities/metrics.h"
 #include "../utilities/tree.h"
@@ -6,31 +6,35 @@
 #include "evaluate.h"
 
 /*! Función inicial que da lugar a las sucecsivas particiones realizadas
-    sobre el conjunto de datos inicial.
+    sobre el conjunto de datos inicial. Con más de un hilo, las particiones
+    de mayor tamaño se cortan en paralelo y las particiones finales se
+    entregan al terminar, en el mismo orden que el particionado secuencial.
   \param partition partición inicial (contiene el conjunto de datos inicial).
-  \return conjunto de datos anonimizados en forma de matriz de dimensión 3.
+  \param threads número de hilos (0 para utilizar todos los núcleos).
+  \param sink destino de las particiones finales.
 */
-vector<vector<vector<string>>> evaluate(Partition partition) {
-  vector<Partition> result;
-  evaluate(partition, result);
-
-  vector<vector<vector<string>>> clusters;
-  for (const auto &p : result) {
-    vector<vector<string>> vec = p.getResult();
-    clusters.emplace_back(vec);
+void evaluate(Partition partition, int threads, PartitionSink &sink) {
+  // Particiones de menor tamaño se cortan de forma secuencial
+  const size_t cutoff = 1 << 12;
+
+  const size_t nThreads = poolThreads(threads);
+  if (nThreads == 1 || partition.size() < cutoff) {
+    evaluate(partition, sink);
+    return;
   }
 
-  return clusters;
+  TaskPool pool(nThreads, cutoff);
+  for (const auto &p : pool.evaluate(partition))
+    sink.add(p);
 }
 
 /*! Contiene el bucle principal del algoritmo y realiza el método de particionado.
   \param partition partición inicial (contiene el conjunto de datos inicial).
-  \param result contiene la lista de particiones auxiliar que contendrá el resultado
-                final cuando finalize el algoritmo.
+  \param sink destino al que se entrega cada partición en cuanto es final.
 */
-void evaluate(Partition partition, vector<Partition> &result) {
+void evaluate(Partition partition, PartitionSink &sink) {
   if (partition.getNumAllowedCuts() == 0) {
-    result.emplace_back(partition);
+    sink.add(partition);
     return;
   }
 
@@ -39,16 +43,42 @@ void evaluate(Partition partition, vector<Partition> &result) {
 
   if (pts.size() == 0) {
     partition.setAllowedCuts(0, dim);
-    evaluate(partition, result);
+    evaluate(partition, sink);
     return;
   }
 
   for (const auto &p : pts)
-    evaluate(p, result);
+    evaluate(p, sink);
 
   return;
 }
 
+/*! Calcula la generalización inicial de cada qid: la raíz de su jerarquía,
+    o el rango de sus valores si es numérico.
+  \param dataset conjunto de datos.
+  \param trees árboles de jerarquía de los qids categóricos.
+  \param allQids índices de los atributos qids.
+  \param isQidCat indica si cada qid es categórico.
+  \return generalización de cada qid.
+*/
+static vector<string> initialGeneralizations(
+    const vector<vector<string>> &dataset, const map<int, Tree> &trees,
+    const vector<int> &allQids, const vector<int> &isQidCat) {
+  vector<string> gens;
+  for (size_t i = 0; i < allQids.size(); i++) {
+    if (isQidCat[i]) {
+      gens.emplace_back(trees.at(allQids[i]).root);
+      continue;
+    }
+
+    // Numeric Value
+    string numRoot = getNumericRoot(dataset, allQids[i]);
+    gens.emplace_back(numRoot);
+  }
+
+  return gens;
+}
+
 /*! Inicializa las estructuras necesarias para llevar a cabo el algoritmo
     Mondrian, haciendo uso de las funciones evaluate que realizan el particionado
     de los datos de entrada.
@@ -57,36 +87,135 @@ void evaluate(Partition partition, vector<Partition> &result) {
   \param allQids índices de los atributos qids.
   \param isQidCat vector que contiene los tipos de cado uno de los atributos qids.
   \param confAtts conjunto de atributos sensibles o SAs.
+  \param orderedAtts atributos sensibles con distancia ordenada en
+                     t-closeness.
   \param K parámetro del modelo de privacidad k-anonymity.
   \param L parámetro del modelo de privacidad l-diversity.
   \param T parámetro del modelo de privacidad t-closeness.
-  \return conjunto de datos anonimizados en forma de matriz de dimensión 3.
+  \param threads número de hilos (0 para utilizar todos los núcleos).
+  \param sink destino de las particiones finales (clases de equivalencia).
 */
-vector<vector<vector<string>>>
-mondrian(vector<vector<string>> dataset,
-         map<int, vector<vector<string>>> hierarchies, vector<int> allQids,
-         vector<int> isQidCat, vector<int> confAtts, const int K, const int L,
-         const long double T) {
-  // 1. Create a hierarchy tree for every qid
+void mondrian(vector<vector<string>> dataset,
+              map<int, vector<vector<string>>> hierarchies,
+              vector<int> allQids, vector<int> isQidCat, vector<int> confAtts,
+              vector<int> orderedAtts, const int K, const int L,
+              const long double T, const int threads, PartitionSink &sink) {
+  // Create a hierarchy tree for every qid
   map<int, Tree> trees;
-  // 2. Initialize default generalizations
+  for (size_t i = 0; i < allQids.size(); i++) {
+    if (isQidCat[i])
+      trees[allQids[i]] = Tree(hierarchies[allQids[i]]);
+  }
+
+  mondrian(dataset, trees, allQids, isQidCat, confAtts, orderedAtts, K, L, T,
+           threads, sink);
+}
+
+/*! Rutina principal del algoritmo Mondrian a partir de los árboles de
+    jerarquía ya construidos, de modo que puedan reutilizarse entre
+    ejecuciones.
+  \param dataset conjunto de datos.
+  \param trees árboles de jerarquía de los qids categóricos.
+  \param allQids índices de los atributos qids.
+  \param isQidCat indica si cada qid es categórico.
+  \param confAtts índices de los atributos sensibles.
+  \param orderedAtts atributos sensibles con distancia ordenada en
+                     t-closeness.
+  \param K parámetro del modelo de privacidad k-anonymity.
+  \param L parámetro del modelo de privacidad l-diversity.
+  \param T parámetro del modelo de privacidad t-closeness.
+  \param threads número de hilos (0 para utilizar todos los núcleos).
+  \param sink destino de las particiones finales (clases de equivalencia).
+*/
+void mondrian(const vector<vector<string>> &dataset,
+              const map<int, Tree> &trees, const vector<int> &allQids,
+              const vector<int> &isQidCat, const vector<int> &confAtts,
+              const vector<int> &orderedAtts, const int K, const int L,
+              const long double T, const int threads, PartitionSink &sink) {
+  // Anonymize whole initial partition
+  const vector<string> gens =
+      initialGeneralizations(dataset, trees, allQids, isQidCat);
+  Partition partition(dataset, gens, allQids, isQidCat, trees, confAtts,
+                      orderedAtts, K, L, T);
+
+  evaluate(partition, threads, sink);
+}
+
+/*! Rutina principal del algoritmo Mondrian repartida entre varios procesos
+    trabajadores: el proceso actual realiza los primeros cortes y coordina
+    a los trabajadores, que particionan el resto. El resultado es el mismo
+    que el del algoritmo en un único proceso.
+  \param dataset conjunto de datos.
+  \param registry registro con las jerarquías y los árboles de los qids
+                  categóricos.
+  \param allQids índices de los atributos qids.
+  \param isQidCat indica si cada qid es categórico.
+  \param confAtts índices de los atributos sensibles.
+  \param orderedAtts atributos sensibles con distancia ordenada en
+                     t-closeness.
+  \param K parámetro del modelo de privacidad k-anonymity.
+  \param L parámetro del modelo de privacidad l-diversity.
+  \param T parámetro del modelo de privacidad t-closeness.
+  \param processes número de procesos trabajadores.
+  \param sink destino de las particiones finales (clases de equivalencia),
+              que deben escribirse en cuanto se obtienen.
+*/
+void mondrian(const vector<vector<string>> &dataset,
+              const HierarchyRegistry &registry, const vector<int> &allQids,
+              const vector<int> &isQidCat, const vector<int> &confAtts,
+              const vector<int> &orderedAtts, const int K, const int L,
+              const long double T, const int processes, PartitionSink &sink) {
+  const map<int, Tree> &trees = registry.getTrees();
+  ProcessPool pool(processes, dataset, registry, allQids, isQidCat, confAtts,
+                   orderedAtts, K, L, T);
+
+  // Anonymize whole initial partition
+  const vector<string> gens =
+      initialGeneralizations(dataset, trees, allQids, isQidCat);
+  Partition partition(dataset, gens, allQids, isQidCat, trees, confAtts,
+                      orderedAtts, K, L, T);
+
+  pool.evaluate(partition, sink);
+}
+
+/*! Rutina principal del algoritmo Mondrian en memoria externa: las
+    particiones que superan el presupuesto de memoria se cortan recorriendo
+    sus ficheros temporales, y el resto con el algoritmo en memoria. El
+    resultado es el mismo que el del algoritmo en memoria.
+  \param dataset conjunto de datos volcado a disco.
+  \param trees árboles de jerarquía de los qids categóricos.
+  \param allQids índices de los atributos qids.
+  \param isQidCat indica si cada qid es categórico.
+  \param confAtts índices de los atributos sensibles.
+  \param orderedAtts atributos sensibles con distancia ordenada en
+                     t-closeness.
+  \param K parámetro del modelo de privacidad k-anonymity.
+  \param L parámetro del modelo de privacidad l-diversity.
+  \param T parámetro del modelo de privacidad t-closeness.
+  \param threads número de hilos (0 para utilizar todos los núcleos).
+  \param sink destino de las particiones finales (clases de equivalencia),
+              que deben escribirse en cuanto se obtienen.
+*/
+void mondrian(const ExternalDataset &dataset, const map<int, Tree> &trees,
+              const vector<int> &allQids, const vector<int> &isQidCat,
+              const vector<int> &confAtts, const vector<int> &orderedAtts,
+              const int K, const int L, const long double T,
+              const int threads, PartitionSink &sink) {
+  // Initialize default generalizations
   vector<string> gens;
   for (size_t i = 0; i < allQids.size(); i++) {
     if (isQidCat[i]) {
-      // Generate a hierarchy tree for every categorical attribute
-      trees[allQids[i]] = Tree(hierarchies[allQids[i]]);
-      gens.emplace_back(trees[allQids[i]].root);
+      gens.emplace_back(trees.at(allQids[i]).root);
       continue;
     }
 
     // Numeric Value
-    string numRoot = getNumericRoot(dataset, allQids[i]);
-    gens.emplace_back(numRoot);
+    gens.emplace_back(dataset.getNumericRoot(allQids[i]));
   }
 
-  // 3. Anonymize whole initial partition
-  Partition partition(dataset, gens, allQids, isQidCat, trees, confAtts, K, L,
-                      T);
+  // Anonymize whole initial partition
+  ExternalPartition partition(dataset, gens, allQids, isQidCat, trees,
+                              confAtts, orderedAtts, K, L, T, threads);
 
-  return evaluate(partition);
+  partition.evaluate(sink);
 }
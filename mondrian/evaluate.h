@@ -7,16 +7,35 @@
 
 using namespace std;
 
+#include "externalPartition.h"
 #include "partition.h"
+#include "partitionSink.h"
+#include "processPool.h"
+#include "taskPool.h"
 #include <iostream>
 #include <vector>
 
-vector<vector<vector<string>>> evaluate(Partition partition);
-void evaluate(Partition partition, vector<Partition> &result);
-vector<vector<vector<string>>>
-mondrian(vector<vector<string>> dataset,
-         map<int, vector<vector<string>>> hierarchies, vector<int> allQids,
-         vector<int> isQidCat, vector<int> confAtts, const int K, const int L,
-         const long double T);
+void evaluate(Partition partition, int threads, PartitionSink &sink);
+void evaluate(Partition partition, PartitionSink &sink);
+void mondrian(vector<vector<string>> dataset,
+              map<int, vector<vector<string>>> hierarchies,
+              vector<int> allQids, vector<int> isQidCat, vector<int> confAtts,
+              vector<int> orderedAtts, const int K, const int L,
+              const long double T, const int threads, PartitionSink &sink);
+void mondrian(const vector<vector<string>> &dataset,
+              const map<int, Tree> &trees, const vector<int> &allQids,
+              const vector<int> &isQidCat, const vector<int> &confAtts,
+              const vector<int> &orderedAtts, const int K, const int L,
+              const long double T, const int threads, PartitionSink &sink);
+void mondrian(const vector<vector<string>> &dataset,
+              const HierarchyRegistry &registry, const vector<int> &allQids,
+              const vector<int> &isQidCat, const vector<int> &confAtts,
+              const vector<int> &orderedAtts, const int K, const int L,
+              const long double T, const int processes, PartitionSink &sink);
+void mondrian(const ExternalDataset &dataset, const map<int, Tree> &trees,
+              const vector<int> &allQids, const vector<int> &isQidCat,
+              const vector<int> &confAtts, const vector<int> &orderedAtts,
+              const int K, const int L, const long double T,
+              const int threads, PartitionSink &sink);
 
 #endif
@@ -0,0 +1,519 @@
+/*! \file externalPartition.cpp
+    \brief Fichero que contiene las clases ExternalDataset y
+           ExternalPartition, que permiten ejecutar Mondrian sobre conjuntos
+           de datos que no caben en memoria.
+*/
+
+#include "externalPartition.h"
+#include "evaluate.h"
+
+/*! Constructor por defecto de la clase ExternalDataset (conjunto vacío).
+  \return instancia del conjunto de datos.
+*/
+ExternalDataset::ExternalDataset() {
+  this->memory = 0;
+  this->rowBytes = 0;
+}
+
+/*! Constructor de la clase ExternalDataset. Vuelca los registros de la
+    tabla a un fichero temporal, en el mismo orden, y copia los
+    diccionarios de cada atributo. La tabla deja de ser necesaria.
+  \param table conjunto de datos codificado.
+  \param memory presupuesto de memoria en bytes.
+  \param directory directorio de los ficheros temporales.
+  \return instancia del conjunto de datos.
+*/
+ExternalDataset::ExternalDataset(const Table &table, size_t memory,
+                                 const string &directory) {
+  this->memory = memory;
+  this->directory = directory;
+
+  // Memoria que ocupa cada valor fuera de su cadena (cadenas largas)
+  const size_t columns = table.numColumns();
+  const size_t shortString = string().capacity();
+  vector<vector<size_t>> valueBytes(columns);
+  for (size_t col = 0; col < columns; col++) {
+    this->dictionaries.emplace_back(table.getColumn(col).getDictionary());
+    for (const string &value : this->dictionaries.back())
+      valueBytes[col].emplace_back(
+          value.size() > shortString ? value.size() + 1 : 0);
+  }
+
+  this->root = make_shared<SpillFile>(spillPath(0), columns);
+  vector<uint32_t> record(columns);
+  size_t heapBytes = 0;
+  for (size_t row = 0; row < table.numRows(); row++) {
+    for (size_t col = 0; col < columns; col++) {
+      record[col] = table.code(row, col);
+      heapBytes += valueBytes[col][record[col]];
+    }
+    this->root->append(record);
+  }
+  this->root->close();
+
+  this->rowBytes = sizeof(vector<string>) + columns * sizeof(string) +
+                   (table.numRows() > 0 ? heapBytes / table.numRows() : 0);
+}
+
+/*! Devuelve el número de registros del conjunto de datos.
+  \return número de registros.
+*/
+size_t ExternalDataset::size() const {
+  return this->root ? this->root->size() : 0;
+}
+
+/*! Devuelve el número de atributos del conjunto de datos.
+  \return número de atributos.
+*/
+size_t ExternalDataset::numColumns() const {
+  return this->dictionaries.size();
+}
+
+/*! Devuelve el diccionario de un atributo.
+  \param column índice del atributo.
+  \return valor correspondiente a cada código.
+*/
+const vector<string> &ExternalDataset::getDictionary(int column) const {
+  return this->dictionaries[column];
+}
+
+/*! Devuelve el fichero temporal con todos los registros.
+  \return fichero temporal.
+*/
+const shared_ptr<SpillFile> &ExternalDataset::getRoot() const {
+  return this->root;
+}
+
+/*! Calcula la generalización raíz de un qid numérico a partir de los
+    valores de su diccionario, que son los valores presentes en el conjunto
+    de datos.
+  \param column índice del atributo.
+  \return generalización raíz.
+*/
+string ExternalDataset::getNumericRoot(int column) const {
+  vector<vector<string>> values;
+  for (const string &value : this->dictionaries[column])
+    values.push_back({value});
+  return ::getNumericRoot(values, 0);
+}
+
+/*! Calcula cuántos registros decodificados caben en el presupuesto de
+    memoria.
+  \param codes enteros adicionales que el algoritmo en memoria guarda por
+               cada registro.
+  \return número de registros.
+*/
+size_t ExternalDataset::budget(size_t codes) const {
+  return this->memory / (this->rowBytes + codes * sizeof(int));
+}
+
+/*! Devuelve la ruta de un fichero temporal. Incluye el identificador del
+    proceso, de modo que varias ejecuciones puedan compartir directorio.
+  \param id identificador del fichero.
+  \return ruta del fichero.
+*/
+string ExternalDataset::spillPath(size_t id) const {
+  const string name = "mondrian_" + to_string(getpid()) + "_" +
+                      to_string(id) + ".spill";
+  return (fs::path(this->directory) / name).string();
+}
+
+/*! Constructor de la clase ExternalPartition. Crea la partición inicial,
+    que abarca todos los registros del conjunto de datos. El conjunto de
+    datos y los árboles jerárquicos no se copian, por lo que deben existir
+    mientras existan sus particiones.
+  \param dataset conjunto de datos volcado a disco.
+  \param generalizations generalización a aplicar a cada qid.
+  \param qids índices de los atributos qids.
+  \param isQidCat vector que contiene los tipos de cado uno de los atributos qids.
+  \param trees árboles de jerarquía de todos los atributos.
+  \param confAtts conjunto de atributos sensibles o SAs.
+  \param orderedAtts atributos sensibles numéricos, que utilizan la distancia
+                     ordenada en t-closeness.
+  \param K parámetro del modelo de privacidad k-anonymity.
+  \param L parámetro del modelo de privacidad l-diversity.
+  \param T parámetro del modelo de privacidad t-closeness.
+  \param threads número de hilos del algoritmo en memoria.
+  \return instancia de la partición creada.
+*/
+ExternalPartition::ExternalPartition(
+    const ExternalDataset &dataset, vector<string> generalizations,
+    vector<int> qids, vector<int> isQidCat, const map<int, Tree> &trees,
+    vector<int> confAtts, vector<int> orderedAtts, int K, int L,
+    long double T, int threads) {
+  this->context = make_shared<ExternalContext>();
+  ExternalContext &context = *this->context;
+  context.dataset = &dataset;
+  context.parameters.data = nullptr;
+  context.parameters.qids = qids;
+  context.parameters.isQidCat = isQidCat;
+  context.parameters.trees = &trees;
+  context.parameters.confAtts = confAtts;
+  context.parameters.K = K;
+  context.parameters.L = L;
+  context.parameters.T = T;
+  context.threads = threads;
+  context.files = 1;
+
+  // Valor o nodo de la jerarquía de cada código de los qids
+  context.numbers.resize(qids.size());
+  context.nodes.resize(qids.size());
+  for (size_t i = 0; i < qids.size(); i++) {
+    const vector<string> &dictionary = dataset.getDictionary(qids[i]);
+    if (isQidCat[i]) {
+      const HierarchyIndex &index = trees.at(qids[i]).getIndex();
+      for (const string &value : dictionary)
+        context.nodes[i].emplace_back(index.find(value));
+      continue;
+    }
+
+    for (const string &value : dictionary)
+      context.numbers[i].emplace_back(stoi(value));
+  }
+
+  // Distribución global de los atributos sensibles, a partir de la
+  // frecuencia de cada código, y código de cada valor en el evaluador
+  if (L > 0 || T > 0) {
+    vector<vector<int>> counts(confAtts.size());
+    for (size_t att = 0; att < confAtts.size(); att++)
+      counts[att].assign(dataset.getDictionary(confAtts[att]).size(), 0);
+    SpillReader reader(*dataset.getRoot());
+    vector<uint32_t> record;
+    while (reader.next(record)) {
+      for (size_t att = 0; att < confAtts.size(); att++)
+        counts[att][record[confAtts[att]]]++;
+    }
+
+    vector<map<string, int>> frequencies(confAtts.size());
+    vector<bool> ordered;
+    for (size_t att = 0; att < confAtts.size(); att++) {
+      const vector<string> &dictionary = dataset.getDictionary(confAtts[att]);
+      for (size_t code = 0; code < dictionary.size(); code++) {
+        if (counts[att][code] > 0)
+          frequencies[att][dictionary[code]] += counts[att][code];
+      }
+      ordered.emplace_back(find(orderedAtts.begin(), orderedAtts.end(),
+                                confAtts[att]) != orderedAtts.end());
+    }
+    context.parameters.sensitive = TClosenessEvaluator(frequencies, ordered);
+
+    context.sensitive.resize(confAtts.size());
+    for (size_t att = 0; att < confAtts.size(); att++) {
+      for (const string &value : dataset.getDictionary(confAtts[att]))
+        context.sensitive[att].emplace_back(
+            frequencies[att].count(value)
+                ? context.parameters.sensitive.encode(att, value)
+                : -1);
+    }
+  }
+
+  // Registros que caben en memoria: cada uno ocupa, además de sus valores,
+  // su posición en la permutación, un entero por qid y uno por atributo
+  // sensible
+  context.budget =
+      dataset.budget(1 + qids.size() + context.parameters.sensitive.size());
+
+  this->file = dataset.getRoot();
+  this->generalizations = generalizations;
+  this->allowedCuts = vector<int>(qids.size(), 1);
+}
+
+/*! Constructor de una partición resultante de un corte.
+  \param context datos compartidos por todas las particiones.
+  \param file fichero temporal con los registros de la partición.
+  \param generalizations generalización a aplicar a cada qid.
+  \return instancia de la partición creada.
+*/
+ExternalPartition::ExternalPartition(shared_ptr<ExternalContext> context,
+                                     shared_ptr<SpillFile> file,
+                                     vector<string> generalizations) {
+  this->context = context;
+  this->file = file;
+  this->generalizations = generalizations;
+  this->allowedCuts = vector<int>(context->parameters.qids.size(), 1);
+}
+
+/*! Devuelve el número de registros de la partición.
+  \return número de registros.
+*/
+size_t ExternalPartition::size() const { return this->file->size(); }
+
+/*! Devuelve el número de cortes permitido por la partición.
+  \return número de cortes.
+*/
+int ExternalPartition::getNumAllowedCuts() {
+  return accumulate(allowedCuts.begin(), allowedCuts.end(), 0);
+}
+
+/*! Calcula una dimensión o qid según la anchura normalizada, contando los
+    valores consecutivos distintos de todas las dimensiones en un único
+    recorrido del fichero.
+  \return dimensión.
+*/
+int ExternalPartition::chooseDimension() {
+  const vector<int> &qids = this->context->parameters.qids;
+  const vector<int> &isQidCat = this->context->parameters.isQidCat;
+  vector<int> widths(qids.size(), 0);
+
+  SpillReader reader(*this->file);
+  vector<uint32_t> record, previous;
+  for (size_t row = 0; reader.next(record); row++) {
+    for (size_t i = 0; i < qids.size(); i++) {
+      if (allowedCuts[i] == 0)
+        continue;
+
+      const uint32_t code = record[qids[i]];
+      if (row == 0)
+        widths[i]++;
+      else if (isQidCat[i] ? code != previous[qids[i]]
+                           : this->context->numbers[i][code] !=
+                                 this->context->numbers[i][previous[qids[i]]])
+        widths[i]++;
+    }
+    swap(record, previous);
+  }
+
+  int dimension, width;
+  dimension = width = -1;
+  for (size_t i = 0; i < qids.size(); i++) {
+    if (allowedCuts[i] != 0 && widths[i] > width) {
+      width = widths[i];
+      dimension = i;
+    }
+  }
+
+  return dimension;
+}
+
+/*! Escribe el fichero temporal de cada subconjunto de un corte, a la vez
+    que calcula su tamaño y el histograma de sus atributos sensibles, y
+    comprueba si cumplen los modelos de privacidad. Los registros conservan
+    el orden de la partición, y los que no pertenecen a ningún subconjunto
+    se descartan.
+  \param dimension dimensión.
+  \param labels subconjunto al que pertenece cada código del qid (-1 si no
+                pertenece a ninguno).
+  \param gens generalización del qid en cada subconjunto.
+  \return vector de particiones, vacío si el corte no es válido.
+*/
+vector<ExternalPartition>
+ExternalPartition::applySplit(int dimension, const vector<int> &labels,
+                              const vector<string> &gens) {
+  ExternalContext &context = *this->context;
+  const PartitionContext &parameters = context.parameters;
+  const int qid = parameters.qids[dimension];
+  const size_t numSplits = gens.size();
+
+  vector<shared_ptr<SpillFile>> files;
+  for (size_t split = 0; split < numSplits; split++)
+    files.emplace_back(make_shared<SpillFile>(
+        context.dataset->spillPath(context.files++), this->file->numColumns()));
+
+  vector<int> sizes(numSplits, 0);
+  vector<vector<vector<int>>> histograms(parameters.sensitive.size());
+  for (size_t att = 0; att < histograms.size(); att++)
+    histograms[att].assign(numSplits,
+                           vector<int>(parameters.sensitive.domain(att), 0));
+
+  SpillReader reader(*this->file);
+  vector<uint32_t> record;
+  while (reader.next(record)) {
+    const int label = labels[record[qid]];
+    if (label == -1)
+      continue;
+
+    sizes[label]++;
+    for (size_t att = 0; att < histograms.size(); att++)
+      histograms[att][label]
+                [context.sensitive[att][record[parameters.confAtts[att]]]]++;
+    files[label]->append(record);
+  }
+
+  // Comprobación modelos de privacidad
+  if (!Partition::areSizesValid(parameters, sizes))
+    return {};
+  for (size_t att = 0; att < histograms.size(); att++) {
+    if (!Partition::isSensitiveValid(parameters, att, histograms[att], sizes))
+      return {};
+  }
+
+  vector<ExternalPartition> pts;
+  for (size_t split = 0; split < numSplits; split++) {
+    files[split]->close();
+    vector<string> generalizations = this->generalizations;
+    generalizations[dimension] = gens[split];
+    pts.emplace_back(
+        ExternalPartition(this->context, files[split], generalizations));
+  }
+
+  return pts;
+}
+
+/*! Realiza un corte sobre una partición utilizando un atributo numérico. El
+    valor medio se obtiene del histograma de los códigos del qid, calculado
+    en un recorrido del fichero, y es el mismo que el de las particiones en
+    memoria: el menor valor cuya frecuencia acumulada alcanza la mitad de
+    los registros.
+  \param dimension dimensión.
+  \return vector de particiones.
+*/
+vector<ExternalPartition>
+ExternalPartition::splitPartitionNumeric(int dimension) {
+  const int qid = this->context->parameters.qids[dimension];
+  const vector<int> &numbers = this->context->numbers[dimension];
+
+  // Histograma de los códigos del qid
+  vector<size_t> counts(numbers.size(), 0);
+  SpillReader reader(*this->file);
+  vector<uint32_t> record;
+  while (reader.next(record))
+    counts[record[qid]]++;
+
+  vector<pair<int, size_t>> histogram;
+  for (size_t code = 0; code < counts.size(); code++) {
+    if (counts[code] > 0)
+      histogram.emplace_back(numbers[code], counts[code]);
+  }
+  sort(histogram.begin(), histogram.end());
+
+  // Corte no permitido
+  const size_t nValues = size();
+  const int low = histogram.empty() ? INT_MAX : histogram.front().first;
+  const int high = histogram.empty() ? INT_MIN : histogram.back().first;
+  if (!Partition::canSplit(this->context->parameters, nValues, low, high))
+    return {};
+
+  // Posición del valor medio en la lista ordenada de valores
+  const size_t pos = (nValues + 1) / 2 - 1;
+  int median = high;
+  size_t aux = 0;
+  for (const auto &[value, count] : histogram) {
+    aux += count;
+    if (aux > pos) {
+      median = value;
+      break;
+    }
+  }
+
+  // Construir nuevas generalizaciones
+  string gen1, gen2;
+  if (!Partition::numericGeneralizations(low, median, high, gen1, gen2))
+    return {};
+
+  vector<int> labels(numbers.size());
+  for (size_t code = 0; code < numbers.size(); code++)
+    labels[code] = numbers[code] <= median ? 0 : 1;
+
+  return applySplit(dimension, labels, {gen1, gen2});
+}
+
+/*! Realiza un corte sobre una partición utilizando un atributo categórico.
+  \param dimension dimensión.
+  \return vector de particiones.
+*/
+vector<ExternalPartition>
+ExternalPartition::splitPartitionCategorical(int dimension) {
+  const int qid = this->context->parameters.qids[dimension];
+  const Tree &tree = this->context->parameters.trees->at(qid);
+  const string &middle = this->generalizations[dimension];
+  vector<string> children = tree.getDirectChildren(middle);
+
+  // If it doesn't have children, return empty vector
+  if (children.size() == 0)
+    return {};
+
+  // Cada código pertenece al hijo que contiene su valor
+  const HierarchyIndex &index = tree.getIndex();
+  const int node = index.find(middle);
+  const vector<int> &nodes = this->context->nodes[dimension];
+  vector<int> labels(nodes.size());
+  for (size_t code = 0; code < nodes.size(); code++)
+    labels[code] = index.childSlot(node, nodes[code]);
+
+  return applySplit(dimension, labels, children);
+}
+
+/*! Realiza un corte sobre una partición.
+  \param dimension dimensión.
+  \return vector de particiones.
+*/
+vector<ExternalPartition> ExternalPartition::splitPartition(int dimension) {
+  // Corte no permitido para esta dimension
+  if (allowedCuts[dimension] == 0)
+    return {};
+
+  if (this->context->parameters.isQidCat[dimension])
+    return splitPartitionCategorical(dimension);
+  return splitPartitionNumeric(dimension);
+}
+
+/*! Carga en memoria los registros de la partición y crea una partición en
+    memoria con sus mismas generalizaciones. Los atributos sensibles
+    conservan la distribución global del conjunto de datos completo.
+  \param data registros decodificados; deben existir mientras exista la
+              partición devuelta.
+  \return partición en memoria.
+*/
+Partition ExternalPartition::load(vector<vector<string>> &data) const {
+  const ExternalContext &context = *this->context;
+  const PartitionContext &parameters = context.parameters;
+
+  data.clear();
+  data.reserve(size());
+  vector<vector<int>> codes(context.sensitive.size());
+  SpillReader reader(*this->file);
+  vector<uint32_t> record;
+  while (reader.next(record)) {
+    vector<string> row;
+    row.reserve(record.size());
+    for (size_t col = 0; col < record.size(); col++)
+      row.emplace_back(context.dataset->getDictionary(col)[record[col]]);
+    data.emplace_back(move(row));
+
+    for (size_t att = 0; att < codes.size(); att++)
+      codes[att].emplace_back(
+          context.sensitive[att][record[parameters.confAtts[att]]]);
+  }
+
+  return Partition(data, this->generalizations, parameters.qids,
+                   parameters.isQidCat, *parameters.trees,
+                   parameters.confAtts,
+                   parameters.sensitive.withCodes(move(codes)), parameters.K,
+                   parameters.L, parameters.T);
+}
+
+/*! Bucle principal del algoritmo en memoria externa. Mientras la partición
+    no cabe en memoria se corta recorriendo su fichero; en cuanto cabe, se
+    carga y se continúa con el algoritmo en memoria. Las particiones finales
+    se entregan en el mismo orden que con el algoritmo en memoria.
+  \param sink destino de las particiones finales. Cada partición se escribe
+              en cuanto es final, ya que sus registros solo existen en
+              memoria mientras se recorren.
+*/
+void ExternalPartition::evaluate(PartitionSink &sink) {
+  vector<vector<string>> data;
+  if (size() <= this->context->budget) {
+    Partition partition = load(data);
+    this->file.reset();
+    ::evaluate(partition, this->context->threads, sink);
+    return;
+  }
+
+  while (getNumAllowedCuts() > 0) {
+    const int dim = chooseDimension();
+    vector<ExternalPartition> pts = splitPartition(dim);
+    if (pts.size() == 0) {
+      allowedCuts[dim] = 0;
+      continue;
+    }
+
+    // Los registros ya se encuentran en los ficheros de los subconjuntos
+    this->file.reset();
+    for (auto &p : pts)
+      p.evaluate(sink);
+    return;
+  }
+
+  // Partición final mayor que el presupuesto de memoria
+  sink.add(load(data));
+}
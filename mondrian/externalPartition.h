@@ -0,0 +1,108 @@
+/*! \file externalPartition.h
+    \brief Fichero de cabecera del archivo externalPartition.cpp.
+*/
+
+#ifndef _EXTERNALPARTITION_H
+#define _EXTERNALPARTITION_H
+
+using namespace std;
+
+#include "../utilities/hierarchy.h"
+#include "../utilities/table.h"
+#include "../utilities/tCloseness.h"
+#include "../utilities/tree.h"
+#include "partition.h"
+#include "partitionSink.h"
+#include "spillFile.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+/*! Clase ExternalDataset. Conjunto de datos volcado a disco para el modo en
+    memoria externa de Mondrian: los registros se guardan codificados en un
+    fichero temporal y en memoria solo se conservan los diccionarios de cada
+    atributo. Conoce además el tamaño aproximado de un registro
+    decodificado, de modo que pueda calcularse cuántos registros caben en
+    el presupuesto de memoria.
+*/
+class ExternalDataset {
+private:
+  vector<vector<string>> dictionaries;
+  shared_ptr<SpillFile> root;
+  size_t memory, rowBytes;
+  string directory;
+
+public:
+  // Constructors
+  ExternalDataset();
+  ExternalDataset(const Table &table, size_t memory, const string &directory);
+  size_t size() const;
+  size_t numColumns() const;
+  const vector<string> &getDictionary(int column) const;
+  const shared_ptr<SpillFile> &getRoot() const;
+  string getNumericRoot(int column) const;
+  size_t budget(size_t codes) const;
+  string spillPath(size_t id) const;
+};
+
+/*! Estructura ExternalContext. Contiene los datos compartidos por todas las
+    particiones en disco: el conjunto de datos, los parámetros del algoritmo
+    (los mismos que utilizan las particiones en memoria), los valores de los
+    qids numéricos, los identificadores en su jerarquía de los valores de
+    los qids categóricos y los códigos de los atributos sensibles, todos
+    ellos indexados por dimensión (o atributo sensible) y código de
+    diccionario, y el número de registros que caben en memoria.
+*/
+struct ExternalContext {
+  const ExternalDataset *dataset;
+  PartitionContext parameters;
+  vector<vector<int>> numbers;
+  vector<vector<int>> nodes;
+  vector<vector<int>> sensitive;
+  size_t budget;
+  int threads;
+  size_t files;
+};
+
+/*! Clase ExternalPartition. Partición de Mondrian cuyos registros se
+    encuentran en un fichero temporal. Los cortes se calculan recorriendo
+    el fichero (un recorrido para elegir la dimensión, otro para el
+    histograma del que se obtiene el valor medio y otro que escribe el
+    fichero de cada subconjunto) y se comprueban con las mismas reglas que
+    las particiones en memoria. En cuanto una partición cabe en el
+    presupuesto de memoria se carga y se continúa con el algoritmo en
+    memoria.
+*/
+class ExternalPartition {
+private:
+  shared_ptr<ExternalContext> context;
+  shared_ptr<SpillFile> file;
+  vector<int> allowedCuts;
+  vector<string> generalizations;
+
+  ExternalPartition(shared_ptr<ExternalContext> context,
+                    shared_ptr<SpillFile> file, vector<string> generalizations);
+  int chooseDimension();
+  vector<ExternalPartition> applySplit(int dimension,
+                                       const vector<int> &labels,
+                                       const vector<string> &gens);
+  vector<ExternalPartition> splitPartitionNumeric(int dimension);
+  vector<ExternalPartition> splitPartitionCategorical(int dimension);
+  vector<ExternalPartition> splitPartition(int dimension);
+  Partition load(vector<vector<string>> &data) const;
+
+public:
+  // Constructor
+  ExternalPartition(const ExternalDataset &dataset,
+                    vector<string> generalizations, vector<int> qids,
+                    vector<int> isQidCat, const map<int, Tree> &trees,
+                    vector<int> confAtts, vector<int> orderedAtts, int K,
+                    int L, long double T, int threads);
+  size_t size() const;
+  int getNumAllowedCuts();
+  void evaluate(PartitionSink &sink);
+};
+
+#endif
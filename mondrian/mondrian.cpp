@@ -1,10 +1,110 @@
 #include "mondrian.h"
 
+/*! Anonimiza el conjunto de datos con unos parámetros dados, escribe el
+    conjunto de datos anonimizado y calcula las métricas. Cada clase de
+    equivalencia se escribe y se añade a las métricas en cuanto se obtiene,
+    por lo que el tiempo de ejecución incluye la escritura y el tiempo de
+    las métricas únicamente su cálculo final.
+  \param dir directorio del conjunto de datos.
+  \param dataset conjunto de datos.
+  \param external conjunto de datos volcado a disco, en el modo en memoria
+                  externa (nullptr si el conjunto de datos está en memoria).
+  \param headers cabecera del fichero.
+  \param registry registro con los árboles de los qids categóricos.
+  \param allQids índices de los atributos qids.
+  \param isQidCat indica si cada qid es categórico.
+  \param confAtts índices de los atributos sensibles.
+  \param orderedAtts atributos sensibles con distancia ordenada en
+                     t-closeness.
+  \param weights pesos de cada qid.
+  \param numMetricsQids qids considerados numéricos en las métricas.
+  \param catMetricsQids qids considerados categóricos en las métricas.
+  \param setting parámetros de los modelos de privacidad.
+  \param threads número de hilos (0 para utilizar todos los núcleos).
+  \param processes número de procesos trabajadores (0 para particionar en
+                   el proceso actual).
+  \return resultado y métricas de la ejecución.
+*/
+SweepResult anonymize(const string &dir, const vector<vector<string>> &dataset,
+                      const ExternalDataset *external,
+                      const vector<string> &headers,
+                      const HierarchyRegistry &registry,
+                      const vector<int> &allQids,
+                      const vector<int> &isQidCat, const vector<int> &confAtts,
+                      const vector<int> &orderedAtts,
+                      const vector<double> &weights,
+                      const vector<int> &numMetricsQids,
+                      const vector<int> &catMetricsQids,
+                      const SweepSetting &setting, const int threads,
+                      const int processes) {
+  SweepResult sweepResult;
+  sweepResult.setting = setting;
+  const int K = setting.K, L = setting.L;
+  const long double T = setting.T;
+  const size_t tableSize = external ? external->size() : dataset.size();
+
+  // Destino de las clases de equivalencia: fichero anonimizado y métricas
+  TableWriter writer(dir, headers, K, L, T);
+  MetricsAccumulator metrics(registry.getTrees(), weights, allQids,
+                             numMetricsQids, catMetricsQids, tableSize, K);
+  PartitionSink sink(writer, metrics);
+
+  // Calcular el tiempo de ejecución
+  auto start = chrono::high_resolution_clock::now();
+  // *********************************
+  // Algoritmo principal
+  if (external)
+    mondrian(*external, registry.getTrees(), allQids, isQidCat, confAtts,
+             orderedAtts, K, L, T, threads, sink);
+  else if (processes > 0)
+    mondrian(dataset, registry, allQids, isQidCat, confAtts, orderedAtts, K,
+             L, T, processes, sink);
+  else
+    mondrian(dataset, registry.getTrees(), allQids, isQidCat, confAtts,
+             orderedAtts, K, L, T, threads, sink);
+  // *********************************
+  auto stop = chrono::high_resolution_clock::now();
+  auto duration = chrono::duration_cast<chrono::seconds>(stop - start);
+  cout << endl << "===> Mondrian Execution Time: ";
+  cout << duration.count() << " seconds" << endl;
+  sweepResult.runSeconds = chrono::duration<double>(stop - start).count();
+
+  cout << "===> Number of clusters: ";
+  cout << sink.size() << endl;
+  sweepResult.clusters = sink.size();
+
+  // Cerrar conjunto de datos anonimizado
+  writer.close();
+
+  // Métricas
+  const auto metricsStart = chrono::steady_clock::now();
+  cout << "===> Analysis: " << endl;
+
+  // GCP
+  sweepResult.gcp = metrics.calculateGCP();
+
+  if (K != -1) {
+    // DM
+    sweepResult.dm = metrics.calculateDM();
+
+    // CAvg
+    sweepResult.cavg = metrics.calculateCAVG();
+  }
+
+  // GenILoss
+  sweepResult.genILoss = metrics.calculateGenILoss();
+  sweepResult.metricsSeconds = elapsedSeconds(metricsStart);
+
+  return sweepResult;
+}
+
 int main(int argc, char **argv) {
+  const bool batch = isBatchMode(argc, argv);
 
-  if (argc != 2) {
+  if (argc != 2 && !batch) {
     cout << "\nInvalid arguments.\n"
-            "Use ./datafly.out [data directory]\n\n"
+            "Use ./mondrian.out [data directory] "
+            "[--batch configuration file]\n\n"
             "* Make sure your data directory meets the following structure:\n"
             "  (check dataset folder for an example)\n\n"
             " |-- [data directory]\n"
@@ -18,15 +118,22 @@ int main(int argc, char **argv) {
     return -1;
   }
 
-  // Leer parámetros
-  const int nqids = readNumberOfQids();
+  // Leer parámetros, de la entrada estándar o del fichero de configuración
+  SweepConfig config;
   vector<string> qidNames;
   vector<string> confAttNames;
   try {
-    // Leer nombres de qids
-    qidNames = readQidNames(nqids);
-    // Leer atributos sensibles
-    confAttNames = readConfidentialAttNames();
+    if (batch) {
+      config = readSweepConfig(argv[3]);
+      qidNames = config.qidNames;
+      confAttNames = config.confAttNames;
+    } else {
+      const int nqids = readNumberOfQids();
+      // Leer nombres de qids
+      qidNames = readQidNames(nqids);
+      // Leer atributos sensibles
+      confAttNames = readConfidentialAttNames();
+    }
   } catch (const char *e) {
     cout << e << endl;
     return -1;
@@ -38,11 +145,27 @@ int main(int argc, char **argv) {
   vector<int> isQidCat;
   map<int, vector<vector<string>>> hierarchiesMap;
   vector<vector<string>> dataset;
+  // Modo en memoria externa: los registros se vuelcan a disco codificados
+  unique_ptr<ExternalDataset> external;
 
+  const auto loadStart = chrono::steady_clock::now();
   try {
-    hierarchiesMap =
-        readDirectory(fs::path(argv[1]), dataset, headers, qidNames,
-                      confAttNames, catQids, confAtts, false);
+    if (config.memory > 0 && config.processes > 0)
+      throw "Error: Worker processes can't be combined with a memory budget";
+    if (batch && config.memory > 0) {
+      Table table;
+      hierarchiesMap =
+          readDirectory(fs::path(argv[1]), table, headers, qidNames,
+                        confAttNames, catQids, confAtts, false);
+      const string spill = config.spill.empty()
+                               ? fs::temp_directory_path().string()
+                               : config.spill;
+      external = make_unique<ExternalDataset>(
+          table, (size_t)config.memory << 20, spill);
+    } else
+      hierarchiesMap =
+          readDirectory(fs::path(argv[1]), dataset, headers, qidNames,
+                        confAttNames, catQids, confAtts, false);
     sort(catQids.begin(), catQids.end());
 
     allQids = getQidsHeaders(headers, qidNames);
@@ -85,79 +208,68 @@ int main(int argc, char **argv) {
     return -1;
   }
 
-  // Leer parámetros vinculados a los modelos de privacidad
-  int K, L;
-  long double T;
-  if (!readParameters(dataset.size(), confAttNames.size(), K, L, T))
-    return -1;
-
-  // Leer pesos asignados a cada qid
-  vector<double> weights = readWeights(nqids, qidNames);
-  // Leer tipos de qids (importante considerar los atributos numéricos como tales)
-  vector<int> numMetricsQids, catMetricsQids;
-  tuple<vector<int>, vector<int>> metricsQids =
-      readMetricsQids(numQids, catQids, headers);
-  numMetricsQids = get<0>(metricsQids);
-  catMetricsQids = get<1>(metricsQids);
-
-  // Calcular el tiempo de ejecución
-  auto start = chrono::high_resolution_clock::now();
-  // *********************************
-  // Algoritmo principal
-  vector<vector<vector<string>>> clusters =
-      mondrian(dataset, hierarchiesMap, allQids, isQidCat, confAtts, K, L, T);
-  // *********************************
-  auto stop = chrono::high_resolution_clock::now();
-  auto duration = chrono::duration_cast<chrono::seconds>(stop - start);
-  cout << endl << "===> Mondrian Execution Time: ";
-  cout << duration.count() << " seconds" << endl;
-
-  cout << "===> Number of clusters: ";
-  cout << clusters.size() << endl;
+  // Convertir árboles jerárquicos en un mapa de datos
+  const HierarchyRegistry registry(move(hierarchiesMap), catQids);
+  const double loadSeconds = elapsedSeconds(loadStart);
+  const size_t tableSize = external ? external->size() : dataset.size();
 
-  // Crear matriz de las clases de equivalencia
-  vector<vector<string>> result;
-  for (const auto &partition : clusters) {
-    result.insert(result.begin(), partition.begin(), partition.end());
-  }
-  // Escribir conjunto de datos anonimizado
-  writeAnonymizedTable(fs::path(argv[1]), headers, result, K, L, T);
+  vector<double> weights;
+  vector<int> numMetricsQids, catMetricsQids, orderedAtts;
+  tuple<vector<int>, vector<int>> metricsQids;
+  if (batch) {
+    try {
+      for (const SweepSetting &setting : config.settings)
+        checkSweepSetting(setting, tableSize, confAttNames.size());
+      weights = sweepWeights(config);
+      orderedAtts = sweepOrderedAtts(config, confAtts, headers);
+      metricsQids = sweepMetricsQids(config, numQids, catQids, headers);
+    } catch (const char *e) {
+      cout << e << endl;
+      return -1;
+    }
+  } else {
+    // Leer parámetros vinculados a los modelos de privacidad
+    SweepSetting setting;
+    if (!readParameters(tableSize, confAttNames.size(), setting.K,
+                        setting.L, setting.T))
+      return -1;
+    config.settings.emplace_back(setting);
 
-  // Métricas
-  cout << "===> Analysis: " << endl;
-  // Convertir árboles jerárquicos en un mapa de datos
-  map<int, Tree> trees;
-  for (const int &i : catQids) {
-    trees[i] = Tree(hierarchiesMap[i]);
+    // Leer pesos asignados a cada qid
+    weights = readWeights(qidNames.size(), qidNames);
+    // Leer tipos de qids (importante considerar los atributos numéricos como
+    // tales)
+    metricsQids = readMetricsQids(numQids, catQids, headers);
   }
+  numMetricsQids = get<0>(metricsQids);
+  catMetricsQids = get<1>(metricsQids);
 
-  // GCP
+  ofstream sweepFile;
+  string sweepName;
   try {
-    // 1. Precalcular NCP para cada atributo qid
-    vector<long double> cncps =
-        calculateNCPS(clusters, weights, allQids, numMetricsQids, trees);
-    // 2. Calcular GCP
-    calculateGCP(clusters, dataset.size(), allQids, cncps);
+    if (batch) {
+      sweepName = sweepOutputName(config, argv[1], "mondrian");
+      sweepFile.open(sweepName);
+      writeSweepHeader(sweepFile);
+    }
+
+    for (const SweepSetting &setting : config.settings) {
+      SweepResult result =
+          anonymize(argv[1], dataset, external.get(), headers, registry,
+                    allQids, isQidCat, confAtts, orderedAtts, weights,
+                    numMetricsQids, catMetricsQids, setting, config.threads,
+                    config.processes);
+      if (batch)
+        writeSweepRow(sweepFile, "mondrian", loadSeconds, result);
+    }
   } catch (const char *e) {
     cout << e << endl;
     return -1;
   }
 
-  if (K != -1) {
-    // DM
-    calculateDM(clusters, dataset.size(), K);
-
-    // CAvg
-    calculateCAVG(clusters, dataset.size(), K);
-  }
-
-  // GenILoss
-  try {
-    calculateGenILoss(transpose(result), trees, allQids, catMetricsQids,
-                      numMetricsQids, dataset.size());
-  } catch (const char *e) {
-    cout << e << endl;
-    return -1;
+  if (batch) {
+    cout << endl << "===> Sweep metrics written to file: " << endl;
+    cout << "\t* " + sweepName << endl;
   }
 
   return 0;
@@ -7,17 +7,33 @@
 
 #include "../utilities/analysis.h"
 #include "../utilities/hierarchy.h"
+#include "../utilities/hierarchyRegistry.h"
 #include "../utilities/input.h"
 #include "../utilities/metrics.h"
+#include "../utilities/metricsAccumulator.h"
+#include "../utilities/sweep.h"
 #include "../utilities/tree.h"
 #include "../utilities/writeData.h"
 #include "evaluate.h"
+#include "externalPartition.h"
 #include "partition.h"
 #include <chrono>
 #include <iostream>
 #include <ostream>
 #include <vector>
 
+SweepResult anonymize(const string &dir, const vector<vector<string>> &dataset,
+                      const ExternalDataset *external,
+                      const vector<string> &headers,
+                      const HierarchyRegistry &registry,
+                      const vector<int> &allQids,
+                      const vector<int> &isQidCat, const vector<int> &confAtts,
+                      const vector<int> &orderedAtts,
+                      const vector<double> &weights,
+                      const vector<int> &numMetricsQids,
+                      const vector<int> &catMetricsQids,
+                      const SweepSetting &setting, const int threads,
+                      const int processes);
 int main(int argc, char **argv);
 
 #endif
@@ -5,43 +5,166 @@
 
 #include "partition.h"
 
-/*! Constructor de la clase Partition.
+/*! Constructor de la clase Partition. Crea la partición inicial, que abarca
+    todos los registros del conjunto de datos. El conjunto de datos no se
+    copia, por lo que debe existir mientras existan sus particiones.
   \param data conjunto de datos.
   \param qids índices de los atributos qids.
   \param generalization generalización a aplicar a cada qid.
   \param isQidCat vector que contiene los tipos de cado uno de los atributos qids.
   \param trees árboles de jerarquía de todos los atributos.
   \param confAtts conjunto de atributos sensibles o SAs.
+  \param orderedAtts atributos sensibles numéricos, que utilizan la distancia
+                     ordenada en t-closeness.
   \param K parámetro del modelo de privacidad k-anonymity.
   \param L parámetro del modelo de privacidad l-diversity.
   \param T parámetro del modelo de privacidad t-closeness.
   \return instancia de la partición creada.
 */
-Partition::Partition(vector<vector<string>> data,
+Partition::Partition(const vector<vector<string>> &data,
                      vector<string> generalizations, vector<int> qids,
-                     vector<int> isQidCat, map<int, Tree> trees,
-                     vector<int> confAtts, int K, int L, long double T) {
-  this->data = data;
+                     vector<int> isQidCat, const map<int, Tree> &trees,
+                     vector<int> confAtts, vector<int> orderedAtts, int K,
+                     int L, long double T)
+    : Partition(data, generalizations, qids, isQidCat, trees, confAtts,
+                // Codificar los atributos sensibles y calcular su
+                // distribución global
+                L > 0 || T > 0
+                    ? TClosenessEvaluator(data, confAtts, orderedAtts)
+                    : TClosenessEvaluator(),
+                K, L, T) {}
+
+/*! Constructor de la clase Partition a partir de los atributos sensibles ya
+    codificados, cuya distribución global puede corresponder a un conjunto
+    de datos mayor del que data es solo una parte. El conjunto de datos no
+    se copia, por lo que debe existir mientras existan sus particiones.
+  \param data conjunto de datos.
+  \param generalizations generalización a aplicar a cada qid.
+  \param qids índices de los atributos qids.
+  \param isQidCat vector que contiene los tipos de cado uno de los atributos qids.
+  \param trees árboles de jerarquía de todos los atributos.
+  \param confAtts conjunto de atributos sensibles o SAs.
+  \param sensitive atributos sensibles codificados para los registros de
+                   data (vacío si no se utiliza l-diversity ni t-closeness).
+  \param K parámetro del modelo de privacidad k-anonymity.
+  \param L parámetro del modelo de privacidad l-diversity.
+  \param T parámetro del modelo de privacidad t-closeness.
+  \return instancia de la partición creada.
+*/
+Partition::Partition(const vector<vector<string>> &data,
+                     vector<string> generalizations, vector<int> qids,
+                     vector<int> isQidCat, const map<int, Tree> &trees,
+                     vector<int> confAtts, TClosenessEvaluator sensitive,
+                     int K, int L, long double T) {
+  this->context = make_shared<PartitionContext>();
+  this->context->data = &data;
+  this->context->rows.resize(data.size());
+  iota(this->context->rows.begin(), this->context->rows.end(), 0);
+  this->context->qids = qids;
+  this->context->isQidCat = isQidCat;
+  this->context->numbers.resize(qids.size());
+  this->context->nodes.resize(qids.size());
+  for (size_t i = 0; i < qids.size(); i++) {
+    if (isQidCat[i]) {
+      const HierarchyIndex &index = trees.at(qids[i]).getIndex();
+      vector<int> &column = this->context->nodes[i];
+      column.reserve(data.size());
+      for (const auto &record : data)
+        column.emplace_back(index.find(record[qids[i]]));
+      continue;
+    }
+
+    vector<int> &column = this->context->numbers[i];
+    column.reserve(data.size());
+    for (const auto &record : data)
+      column.emplace_back(stoi(record[qids[i]]));
+  }
+  this->context->trees = &trees;
+  this->context->confAtts = confAtts;
+  this->context->sensitive = move(sensitive);
+  this->context->K = K;
+  this->context->L = L;
+  this->context->T = T;
+
+  this->begin = 0;
+  this->end = data.size();
   this->generalizations = generalizations;
-  this->qids = qids;
-  this->isQidCat = isQidCat;
-  this->trees = trees;
-  this->confAtts = confAtts;
-  this->K = K;
-  this->L = L;
-  this->T = T;
   this->allowedCuts = vector<int>(qids.size(), 1);
 }
 
+/*! Constructor de una partición resultante de un corte.
+  \param context datos compartidos por todas las particiones.
+  \param begin inicio del rango de registros de la partición.
+  \param end fin del rango de registros de la partición.
+  \param generalizations generalización a aplicar a cada qid.
+  \return instancia de la partición creada.
+*/
+Partition::Partition(shared_ptr<PartitionContext> context, size_t begin,
+                     size_t end, vector<string> generalizations) {
+  this->context = context;
+  this->begin = begin;
+  this->end = end;
+  this->generalizations = generalizations;
+  this->allowedCuts = vector<int>(context->qids.size(), 1);
+}
+
+/*! Devuelve el valor de un atributo de un registro de la partición.
+  \param pos posición del registro en la permutación compartida.
+  \param column índice del atributo.
+  \return valor del atributo.
+*/
+const string &Partition::value(size_t pos, int column) const {
+  return (*this->context->data)[this->context->rows[pos]][column];
+}
+
+/*! Devuelve el valor de un qid numérico de un registro de la partición.
+  \param pos posición del registro en la permutación compartida.
+  \param dimension dimensión.
+  \return valor del qid.
+*/
+int Partition::number(size_t pos, int dimension) const {
+  return this->context->numbers[dimension][this->context->rows[pos]];
+}
+
+/*! Devuelve el número de registros de la partición.
+  \return número de registros.
+*/
+size_t Partition::size() const { return this->end - this->begin; }
+
+/*! Devuelve la posición del primer registro de la partición en la
+    permutación compartida. Las particiones finales no se solapan, por lo
+    que esta posición las ordena según el recorrido del algoritmo.
+  \return posición del primer registro.
+*/
+size_t Partition::getBegin() const { return this->begin; }
+
+/*! Devuelve los registros de la partición, en el orden de la misma.
+  \return índices de los registros en el conjunto de datos.
+*/
+vector<int> Partition::getRows() const {
+  return vector<int>(this->context->rows.begin() + this->begin,
+                     this->context->rows.begin() + this->end);
+}
+
+/*! Devuelve la generalización de cada qid en la partición.
+  \return generalizaciones.
+*/
+const vector<string> &Partition::getGeneralizations() const {
+  return this->generalizations;
+}
+
 /*! Generaliza el conjunto de datos perteneciente a la partición.
   \return conjunto de datos anonimizado en forma de matriz de dimensión 2.
 */
 vector<vector<string>> Partition::getResult() const {
-  vector<vector<string>> result = data;
+  const vector<int> &qids = this->context->qids;
+  vector<vector<string>> result;
+  result.reserve(size());
 
-  for (size_t i = 0; i < data.size(); i++) {
+  for (size_t i = this->begin; i < this->end; i++) {
+    result.emplace_back((*this->context->data)[this->context->rows[i]]);
     for (size_t j = 0; j < qids.size(); j++) {
-      result[i][qids[j]] = generalizations[j];
+      result.back()[qids[j]] = generalizations[j];
     }
   }
 
@@ -68,7 +191,7 @@ int Partition::chooseDimension() {
   int dimension, width;
   dimension = width = -1;
 
-  for (size_t i = 0; i < qids.size(); i++) {
+  for (size_t i = 0; i < this->context->qids.size(); i++) {
     if (allowedCuts[i] == 0)
       continue;
 
@@ -82,237 +205,253 @@ int Partition::chooseDimension() {
   return dimension;
 }
 
-/*! Devuelve el número normalizado de elementos incluidos en la partición.
+/*! Devuelve el número normalizado de elementos incluidos en la partición,
+    contando los valores consecutivos distintos en el orden de la partición.
   \param dimension dimensión.
   \return valor normalizado.
 */
 int Partition::normWidth(int dimension) {
   // Rango normalizado de valores para la dimensión
-  vector<string> elements;
-  for (const vector<string> &entry : data) {
-    elements.emplace_back(entry[qids[dimension]]);
+  int width = 0;
+  if (!this->context->isQidCat[dimension]) {
+    for (size_t i = this->begin; i < this->end; i++) {
+      if (i == this->begin ||
+          number(i, dimension) != number(i - 1, dimension))
+        width++;
+    }
+    return width;
   }
 
-  auto it = unique(elements.begin(), elements.end());
-  elements.resize(distance(elements.begin(), it));
+  const int qid = this->context->qids[dimension];
+  for (size_t i = this->begin; i < this->end; i++) {
+    if (i == this->begin || value(i, qid) != value(i - 1, qid))
+      width++;
+  }
 
-  return elements.size();
+  return width;
 }
 
-/*! Calcula el valor medio de la partición. Utilizado para valores numéricos.
+/*! Calcula el valor medio de la partición y los valores extremos presentes
+    en la misma, recorriendo sus valores una única vez. Utilizado para
+    valores numéricos. El valor medio es el menor valor cuya frecuencia
+    acumulada alcanza la mitad de los registros.
   \param dimension dimensión.
-  \return valor normalizado.
+  \param median valor medio.
+  \param lowest valor mínimo.
+  \param highest valor máximo.
+  \return 1 si se puede realizar el corte, 0 si no es así.
 */
-string Partition::findMedian(int dimension) {
-  // Calculate qid frecuencies (qid values are sorted)
-  map<string, int> map = calculateQidFreqs(this->data, qids[dimension]);
-  vector<pair<string, int>> freqs;
-  freqs.resize(map.size());
-  copy(map.begin(), map.end(), freqs.begin());
-
-  // Sort values
-  sort(freqs.begin(), freqs.end(),
-       [](const pair<string, int> &x, const pair<string, int> &y) {
-         return stoi(x.first) < stoi(y.first);
-       });
-
-  // Sumar todos los valores
-  vector<int> values;
-  transform(freqs.begin(), freqs.end(), std::back_inserter(values),
-            [](const auto &tuple) { return tuple.second; });
-  int nValues = accumulate(values.begin(), values.end(), 0);
+bool Partition::findMedian(int dimension, int &median, int &lowest,
+                           int &highest) {
+  // Valores de la dimensión y valores extremos
+  const size_t nValues = size();
+  vector<int> values(nValues);
+  lowest = INT_MAX;
+  highest = INT_MIN;
+  for (size_t i = 0; i < nValues; i++) {
+    values[i] = number(this->begin + i, dimension);
+    lowest = min(lowest, values[i]);
+    highest = max(highest, values[i]);
+  }
 
-  // Encontrar valor medio
-  double middle = nValues / 2.0;
   // Comprobar si se puede realizar el corte
-  if (freqs.size() < 2 || middle < K || middle < L || middle < T) {
-    return "";
-  }
+  if (!canSplit(*this->context, nValues, lowest, highest))
+    return false;
 
-  // Calcular el valor final a partir de la lista de frecuencias
-  string splitValue;
-  int aux = 0;
-  for (size_t i = 0; i < freqs.size(); i++) {
-    aux += freqs[i].second;
-    if (aux >= middle) {
-      splitValue = freqs[i].first;
-      break;
+  // Posición del valor medio en la lista ordenada de valores
+  const size_t pos = (nValues + 1) / 2 - 1;
+
+  // Dominio pequeño: histograma de frecuencias
+  const long long domain = (long long)highest - lowest + 1;
+  if (domain <= (long long)nValues) {
+    vector<int> counts(domain, 0);
+    for (const int &value : values)
+      counts[value - lowest]++;
+
+    size_t aux = 0;
+    for (long long i = 0; i < domain; i++) {
+      aux += counts[i];
+      if (aux > pos) {
+        median = lowest + i;
+        break;
+      }
     }
+    return true;
   }
 
-  return splitValue;
+  nth_element(values.begin(), values.begin() + pos, values.end());
+  median = values[pos];
+  return true;
 }
 
-/*! Devuelve el rango sobre el que se situan los valores de una dimensión dada.
-  \param dimension dimensión.
-  \return vector de longitud 2.
+/*! Comprueba si una partición puede cortarse por un qid numérico a partir
+    de su número de registros y de los valores extremos del qid: cada mitad
+    debe poder contener, al menos, K registros (y L y T).
+  \param context datos compartidos por todas las particiones.
+  \param nValues número de registros de la partición.
+  \param lowest valor mínimo.
+  \param highest valor máximo.
+  \return 1 si se puede realizar el corte, 0 si no es así.
 */
-vector<int> Partition::getAttributeRanges(int dimension) {
-  vector<int> values;
-  for (const auto &record : this->data) {
-    values.emplace_back(stoi(record[qids[dimension]]));
-  }
+bool Partition::canSplit(const PartitionContext &context, size_t nValues,
+                         int lowest, int highest) {
+  // Encontrar valor medio
+  double middle = nValues / 2.0;
+  return !(nValues == 0 || lowest == highest || middle < context.K ||
+           middle < context.L || middle < context.T);
+}
 
-  int min = *min_element(values.begin(), values.end());
-  int max = *max_element(values.begin(), values.end());
+/*! Construye las generalizaciones de las dos mitades de un corte numérico.
+  \param lowest valor mínimo.
+  \param median valor medio.
+  \param highest valor máximo.
+  \param gen1 generalización de la primera mitad (valores <= median).
+  \param gen2 generalización de la segunda mitad (valores > median).
+  \return 1 si el corte es posible, 0 si se ha alcanzado el límite de cortes.
+*/
+bool Partition::numericGeneralizations(int lowest, int median, int highest,
+                                       string &gen1, string &gen2) {
+  string splitValue, split1, split2;
+  splitValue = split1 = to_string(median);
+  split2 = to_string(median + 1);
+
+  string low, high;
+  low = to_string(lowest);
+  high = to_string(highest);
 
-  return {min, max};
+  // Límite de cortes
+  if (highest == median)
+    return false;
+
+  gen1 = low == splitValue ? splitValue
+                           : (low == split1 ? low : low + "~" + split1);
+  gen2 = high == splitValue ? splitValue
+                            : (high == split2 ? high : split2 + "~" + high);
+  return true;
 }
 
-/*! Comprueba si la partición es k-anonima.
-  \param split partición.
-  \return 1 si la partición es k-anonima, o 0 si no lo es.
+/*! Comprueba el tamaño de los subconjuntos resultantes de un corte: ninguno
+    puede estar vacío ni, con k-anonymity, contener menos de K registros.
+  \param context datos compartidos por todas las particiones.
+  \param sizes número de registros de cada subconjunto.
+  \return 1 si todos los subconjuntos lo cumplen, o 0 si no es así.
 */
-bool Partition::isSplitKAnonymous(vector<vector<string>> split) {
-	// Obtener registros conteniendo unicamente qids
-  vector<vector<string>> qidsDataset;
-	for (size_t i=0; i < split.size(); i++) {
-		vector<string> aux;
-		for (const int& idx : qids) {
-			aux.emplace_back(split[i][idx]);
-		}
-		qidsDataset.emplace_back(aux);
-	}
-
-  for (const int &freq : calculateFreqs(qidsDataset)) {
-    if (freq < K) {
+bool Partition::areSizesValid(const PartitionContext &context,
+                              const vector<int> &sizes) {
+  for (const int &splitSize : sizes) {
+    if (splitSize == 0)
+      return false;
+    // k-anonymity
+    if (context.K > 0 && splitSize < context.K)
       return false;
-    }
   }
 
   return true;
 }
 
-/*! Comprueba si la partición es l-diversa.
-  \param split partición.
-  \return 1 si la partición es l-diversa, o 0 si no lo es.
+/*! Comprueba l-diversity y t-closeness para un atributo sensible en los
+    subconjuntos resultantes de un corte.
+  \param context datos compartidos por todas las particiones.
+  \param att posición del atributo en la lista de atributos sensibles.
+  \param histograms histograma del atributo en cada subconjunto.
+  \param sizes número de registros de cada subconjunto.
+  \return 1 si todos los subconjuntos lo cumplen, o 0 si no es así.
 */
-bool Partition::isSplitLDiverse(vector<vector<string>> split) {
-  vector<map<string, int>> freqs(confAtts.size());
-  string key;
-
-  for (const auto &entry : split) {
-    for (size_t j = 0; j < confAtts.size(); j++) {
-      key = entry[confAtts[j]];
-      try {
-        freqs[j][key] += 1;
-      } catch (...) {
-        freqs[j][key] = 1;
-      }
-    }
-  }
+bool Partition::isSensitiveValid(const PartitionContext &context, size_t att,
+                                 const vector<vector<int>> &histograms,
+                                 const vector<int> &sizes) {
+  for (size_t split = 0; split < histograms.size(); split++) {
+    // l-diversity: cada atributo confidencial debe tener, al menos,
+    // l valores "bien representados"
+    if (context.L > 0 &&
+        count_if(histograms[split].begin(), histograms[split].end(),
+                 [](const int &count) { return count > 0; }) < context.L)
+      return false;
 
-  // Cada atributo confidencial debe tener, al menos,
-  // l valores "bien representados"
-  for (const map<string, int> &attFreq : freqs) {
-    if ((int)attFreq.size() < L)
+    // t-closeness: EMD entre la distribución del subconjunto (P) y la
+    // del conjunto de datos (Q)
+    if (context.T > 0 &&
+        context.sensitive.emd(att, histograms[split], sizes[split]) >
+            context.T)
       return false;
   }
 
   return true;
 }
 
-/*! Comprueba si la partición cumple el modelo de privacidad t-closeness.
-  \param split partición.
-  \return 1 si la partición sí lo cumple, o 0 si no es así.
+/*! Comprueba si los subconjuntos resultantes de un corte cumplen los modelos
+    de privacidad seleccionados. Todos los registros de un subconjunto
+    comparten la misma generalización, por lo que cada subconjunto forma una
+    única clase de equivalencia y basta con su tamaño y los histogramas de
+    sus atributos sensibles, obtenidos al recorrer el corte.
+  \param labels subconjunto al que pertenece cada registro de la partición
+                (-1 si no pertenece a ninguno).
+  \param numSplits número de subconjuntos.
+  \return 1 si todos los subconjuntos los cumplen, o 0 si no es así.
 */
-bool Partition::isSplitTClose(vector<vector<string>> split) {
-  if (split.size() == 0)
-    return false;
-
-  // Obtener tablas transpuestas
-  vector<vector<string>> tSplit = transpose(split);
-  vector<vector<string>> tData = transpose(data);
-
-  // Generar un mapa de frecuencias de P
-  vector<map<string, int>> splitMaps;
-  for (const auto &att : confAtts) {
-    map<string, int> freqs;
-    for (const auto &entry : tSplit[att]) {
-      try {
-        freqs[entry] += 1;
-      } catch (...) {
-        freqs[entry] = 1;
-      }
-    }
-    splitMaps.emplace_back(freqs);
+bool Partition::isSplitValid(const vector<int> &labels, int numSplits) {
+  const PartitionContext &context = *this->context;
+  vector<int> sizes(numSplits, 0);
+  for (const int &label : labels) {
+    if (label != -1)
+      sizes[label]++;
   }
 
-  // Generar un mapa de frecuencias de Q
-  // y una lista de entradas
-  vector<map<string, int>> dataMaps;
-  vector<set<string>> valueSets;
-  for (const auto &att : confAtts) {
-    set<string> entries;
-    map<string, int> freqs;
-    for (const auto &entry : tData[att]) {
-      entries.insert(entry);
-      try {
-        freqs[entry] += 1;
-      } catch (...) {
-        freqs[entry] = 1;
-      }
-    }
-    dataMaps.emplace_back(freqs);
-    valueSets.emplace_back(entries);
-  }
+  if (!areSizesValid(context, sizes))
+    return false;
 
-  int pSize, qSize;
-  pSize = split.size();
-  qSize = data.size();
-
-  // Calcular EMD para cada atributo confidencial
-  // utilizando ED
-  long double emd;
-  for (size_t i = 0; i < confAtts.size(); i++) {
-    emd = 0;
-    for (const auto &entry : valueSets[i]) {
-      if (splitMaps[i][entry]) {
-        // Entrada presente en P
-        // ED(Pi, Qi) = abs(Pi/Pi probability in P -
-        // 					 Qi/Qi probability in Q)
-        emd += abs((long double)splitMaps[i][entry] / pSize -
-                   (long double)dataMaps[i][entry] / qSize);
-      } else {
-        // Entrada no presente P
-        // ED(Pi, Qi) = abs(0 - Qi/Qi probability in Q)
-        emd += (long double)dataMaps[i][entry] / qSize;
-      }
+  for (size_t att = 0; att < context.sensitive.size(); att++) {
+    // Histograma del atributo sensible en cada subconjunto
+    const vector<int> &codes = context.sensitive.getCodes(att);
+    vector<vector<int>> histograms(numSplits,
+                                   vector<int>(context.sensitive.domain(att)));
+    for (size_t i = 0; i < labels.size(); i++) {
+      if (labels[i] != -1)
+        histograms[labels[i]][codes[context.rows[this->begin + i]]]++;
     }
 
-    // ED(P, Q) =  sum(sum(pj - qj)) / 2
-    emd /= 2;
-
-    // Comprobar t-closeness
-    if (emd > T)
+    if (!isSensitiveValid(context, att, histograms, sizes))
       return false;
   }
 
   return true;
 }
 
-/*! Comprueba si la partición cumple los modelos de privacidad seleccionados.
-  \param split partición.
-  \return 1 si la partición los cumple, o 0 si no es así.
+/*! Reordena el rango de la partición en la permutación compartida de modo
+    que los registros de cada subconjunto queden contiguos. La reordenación
+    es estable, y los registros que no pertenecen a ningún subconjunto se
+    sitúan al final del rango.
+  \param labels subconjunto al que pertenece cada registro de la partición
+                (-1 si no pertenece a ninguno).
+  \param numSplits número de subconjuntos.
+  \param bounds límites de cada subconjunto en la permutación (numSplits + 1
+                valores).
 */
-bool Partition::isSplitValid(vector<vector<string>> split) {
-  bool kanonymity, ldiversity, tcloseness;
-  kanonymity = ldiversity = tcloseness = true;
-
-  if (split.size() == 0)
-    return false;
-
-  if (K > 0) {
-    kanonymity = isSplitKAnonymous(split);
-  }
-  if (L > 0) {
-    ldiversity = isSplitLDiverse(split);
-  }
-  if (T > 0) {
-    tcloseness = isSplitTClose(split);
+void Partition::applySplit(const vector<int> &labels, int numSplits,
+                           vector<size_t> &bounds) {
+  vector<int> &rows = this->context->rows;
+
+  // El último grupo contiene los registros descartados
+  vector<size_t> offsets(numSplits + 1, 0);
+  for (const int &label : labels)
+    offsets[label == -1 ? numSplits : label]++;
+
+  bounds.assign(numSplits + 1, this->begin);
+  size_t sum = 0;
+  for (int split = 0; split <= numSplits; split++) {
+    const size_t count = offsets[split];
+    offsets[split] = sum;
+    bounds[split] = this->begin + sum;
+    sum += count;
   }
+  bounds[numSplits] = this->begin + offsets[numSplits];
 
-  return kanonymity && ldiversity && tcloseness;
+  vector<int> buffer(labels.size());
+  for (size_t i = 0; i < labels.size(); i++) {
+    const int label = labels[i] == -1 ? numSplits : labels[i];
+    buffer[offsets[label]++] = rows[this->begin + i];
+  }
+  copy(buffer.begin(), buffer.end(), rows.begin() + this->begin);
 }
 
 /*! Realiza un corte sobre una partición.
@@ -325,7 +464,7 @@ vector<Partition> Partition::splitPartition(int dimension) {
     return {};
   }
 
-  if (isQidCat[dimension])
+  if (this->context->isQidCat[dimension])
     return splitPartitionCategorical(dimension);
   return splitPartitionNumeric(dimension);
 }
@@ -335,75 +474,42 @@ vector<Partition> Partition::splitPartition(int dimension) {
   \return vector de particiones.
 */
 vector<Partition> Partition::splitPartitionNumeric(int dimension) {
-  // Obtener el valor medio
-  string splitValue = findMedian(dimension);
+  // Obtener el valor medio y los valores extremos presentes en la partición
+  int median, low, high;
   // Corte no permitido
-  if (splitValue == "") {
+  if (!findMedian(dimension, median, low, high)) {
     return {};
   }
 
-  string split1, split2;
-  split1 = splitValue;
-  split2 = to_string(stoi(splitValue) + 1);
-
-  // Obtener valores extremos presentes en la partición,
-  string lowest, highest;
-  vector<int> range = getAttributeRanges(dimension);
-  lowest = to_string(range[0]);
-  highest = to_string(range[1]);
-
-  // Límite de cortes
-  if (highest == split1) {
+  // Construir nuevas generalizaciones (límite de cortes si el valor medio
+  // es el máximo)
+  string gen1, gen2;
+  if (!numericGeneralizations(low, median, high, gen1, gen2)) {
     this->setAllowedCuts(0, dimension);
     return {};
   }
 
-  // Construir nuevas generalizaciones
-  string gen1 = lowest == splitValue
-                    ? splitValue
-                    : (lowest == split1 ? lowest : lowest + "~" + split1);
-  string gen2 = highest == splitValue
-                    ? splitValue
-                    : (highest == split2 ? highest : split2 + "~" + highest);
-
   // Nuevas particiones
-  vector<vector<string>> d1, d2;
-  for (const auto &record : this->data) {
-    int number = stoi(record[qids[dimension]]);
-    if (number <= stoi(split1))
-      d1.emplace_back(record);
-    else
-      d2.emplace_back(record);
-  }
-
-  // generalizar d1
-  vector<vector<string>> s1 = d1;
-  for (size_t i = 0; i < s1.size(); i++) {
-    for (size_t j = 0; j < generalizations.size(); j++)
-      s1[i][qids[j]] = generalizations[j];
-    s1[i][dimension] = gen1;
-  }
-  // generalizar d2
-  vector<vector<string>> s2 = d1;
-  for (size_t i = 0; i < s2.size(); i++) {
-    for (size_t j = 0; j < generalizations.size(); j++)
-      s2[i][qids[j]] = generalizations[j];
-    s2[i][dimension] = gen2;
-  }
+  vector<int> labels(size());
+  for (size_t i = this->begin; i < this->end; i++)
+    labels[i - this->begin] = number(i, dimension) <= median ? 0 : 1;
 
   // Comprobación modelos de privacidad
-  if (!isSplitValid(s1) || !isSplitValid(s2)) {
+  if (!isSplitValid(labels, 2)) {
     this->setAllowedCuts(0, dimension);
     return {};
   }
 
+  vector<size_t> bounds;
+  applySplit(labels, 2, bounds);
+
   // Actualizar array de generalizaciones
   vector<string> gens1, gens2;
   gens1 = gens2 = this->generalizations;
   gens1[dimension] = gen1;
   gens2[dimension] = gen2;
-  Partition p1(d1, gens1, qids, isQidCat, trees, confAtts, K, L, T);
-  Partition p2(d2, gens2, qids, isQidCat, trees, confAtts, K, L, T);
+  Partition p1(this->context, bounds[0], bounds[1], gens1);
+  Partition p2(this->context, bounds[1], bounds[2], gens2);
 
   return {p1, p2};
 }
@@ -415,7 +521,8 @@ vector<Partition> Partition::splitPartitionNumeric(int dimension) {
 vector<Partition> Partition::splitPartitionCategorical(int dimension) {
 
   vector<Partition> pts;
-  Tree tree = trees[qids[dimension]];
+  const int qid = this->context->qids[dimension];
+  const Tree &tree = this->context->trees->at(qid);
   string middle = this->generalizations[dimension];
   vector<string> children = tree.getDirectChildren(middle);
 
@@ -423,48 +530,31 @@ vector<Partition> Partition::splitPartitionCategorical(int dimension) {
   if (children.size() == 0)
     return pts;
 
-  // Split records based on dimension (qid) generalization values
-  vector<vector<vector<string>>> splits(children.size(),
-                                        vector<vector<string>>());
-  for (const auto &record : this->data) {
-    string qid = record[qids[dimension]];
-
-    int i = 0;
-    for (const auto &child : children) {
-      if (!tree.isChild(child, qid)) {
-        i++;
-        continue;
-      }
-      splits[i].emplace_back(record);
-      break;
-    }
-  }
-
-  // Generalizar split y comprobar modelos de privacidad
-  for (size_t idx = 0; idx < splits.size(); idx++) {
-    vector<vector<string>> aux = splits[idx];
-    for (size_t i = 0; i < aux.size(); i++) {
-      for (size_t j = 0; j < generalizations.size(); j++)
-        aux[i][qids[j]] = generalizations[j];
-      aux[i][dimension] = children[idx];
-    }
-  
-    if (!isSplitValid(aux)) {
-      this->setAllowedCuts(0, dimension);
-      return pts;
-    }
+  // Split records based on dimension (qid) generalization values: cada
+  // registro pertenece al hijo que contiene su valor. Los registros cuyo
+  // valor no pertenece a ningún hijo no forman parte de ningún subconjunto
+  const HierarchyIndex &index = tree.getIndex();
+  const int node = index.find(middle);
+  const vector<int> &nodes = this->context->nodes[dimension];
+  vector<int> labels(size());
+  for (size_t i = this->begin; i < this->end; i++)
+    labels[i - this->begin] =
+        index.childSlot(node, nodes[this->context->rows[i]]);
+
+  // Comprobar modelos de privacidad
+  if (!isSplitValid(labels, children.size())) {
+    this->setAllowedCuts(0, dimension);
+    return pts;
   }
 
   // Actualizar array de generalizaciones y actualizar
   // particiones
-  for (size_t i = 0; i < splits.size(); i++) {
-    if (splits[i].size() != 0) {
-      vector<string> gens = generalizations;
-      gens[dimension] = children[i];
-      Partition p =
-          Partition(splits[i], gens, qids, isQidCat, trees, confAtts, K, L, T);
-      pts.emplace_back(p);
-    }
+  vector<size_t> bounds;
+  applySplit(labels, children.size(), bounds);
+  for (size_t i = 0; i < children.size(); i++) {
+    vector<string> gens = generalizations;
+    gens[dimension] = children[i];
+    pts.emplace_back(Partition(this->context, bounds[i], bounds[i + 1], gens));
   }
 
   return pts;
@@ -9,51 +9,97 @@ using namespace std;
 
 #include "../utilities/frequencies.h"
 #include "../utilities/hierarchy.h"
+#include "../utilities/tCloseness.h"
 #include "../utilities/tree.h"
 #include <algorithm>
 #include <array>
+#include <climits>
 #include <iostream>
+#include <map>
 #include <math.h>
+#include <memory>
 #include <numeric>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <vector>
 
+/*! Estructura PartitionContext. Contiene los datos compartidos por todas
+    las particiones: el conjunto de datos original, una permutación de sus
+    registros (cada partición ocupa un rango contiguo de la misma), los
+    valores de los qids numéricos ya convertidos a entero y los
+    identificadores en su jerarquía de los valores de los qids categóricos
+    (ambos indexados por dimensión y registro), los atributos sensibles
+    codificados junto a su distribución global (solo si se utiliza
+    l-diversity o t-closeness) y los parámetros del algoritmo. Tanto el
+    conjunto de datos como los árboles jerárquicos se referencian sin
+    copiarse, por lo que deben existir mientras existan las particiones.
+*/
+struct PartitionContext {
+  const vector<vector<string>> *data;
+  vector<int> rows;
+  vector<int> qids, isQidCat;
+  vector<vector<int>> numbers;
+  vector<vector<int>> nodes;
+  const map<int, Tree> *trees;
+  vector<int> confAtts;
+  TClosenessEvaluator sensitive;
+  int K, L;
+  long double T;
+};
+
 /*! Clase Partition. Su función es contener todas las estructuras necesarias
     para proporcionar los métodos que den lugar al procedimiento de particionado
-    de una tabla de datos.
+    de una tabla de datos. Una partición no copia los registros, sino que
+    referencia un rango [begin, end) de la permutación compartida.
 */
 class Partition {
 private:
+  shared_ptr<PartitionContext> context;
+  size_t begin, end;
   vector<int> allowedCuts;
-  vector<vector<string>> data;
-  vector<int> qids, isQidCat;
-  map<int, Tree> trees;
-  vector<int> confAtts;
-  int K, L;
-  long double T;
   vector<string> generalizations;
 
-  string findMedian(int dimension);
+  Partition(shared_ptr<PartitionContext> context, size_t begin, size_t end,
+            vector<string> generalizations);
+  const string &value(size_t pos, int column) const;
+  int number(size_t pos, int dimension) const;
+  bool findMedian(int dimension, int &median, int &lowest, int &highest);
   int normWidth(int dimension);
-  vector<int> getAttributeRanges(int dimension);
-  bool isSplitKAnonymous(vector<vector<string>> split);
-  bool isSplitLDiverse(vector<vector<string>> split);
-  bool isSplitTClose(vector<vector<string>> split);
-  bool isSplitValid(vector<vector<string>> split);
+  bool isSplitValid(const vector<int> &labels, int numSplits);
+  void applySplit(const vector<int> &labels, int numSplits,
+                  vector<size_t> &bounds);
   vector<Partition> splitPartitionNumeric(int dimension);
   vector<Partition> splitPartitionCategorical(int dimension);
 
 public:
   // Constructor
-  Partition(vector<vector<string>> data, vector<string> generalizations,
-            vector<int> qids, vector<int> isQidCat, map<int, Tree> trees,
-            vector<int> confAtts, int K, int L, long double T);
+  Partition(const vector<vector<string>> &data, vector<string> generalizations,
+            vector<int> qids, vector<int> isQidCat,
+            const map<int, Tree> &trees, vector<int> confAtts,
+            vector<int> orderedAtts, int K, int L, long double T);
+  Partition(const vector<vector<string>> &data, vector<string> generalizations,
+            vector<int> qids, vector<int> isQidCat,
+            const map<int, Tree> &trees, vector<int> confAtts,
+            TClosenessEvaluator sensitive, int K, int L, long double T);
+  static bool canSplit(const PartitionContext &context, size_t nValues,
+                       int lowest, int highest);
+  static bool numericGeneralizations(int lowest, int median, int highest,
+                                     string &gen1, string &gen2);
+  static bool areSizesValid(const PartitionContext &context,
+                            const vector<int> &sizes);
+  static bool isSensitiveValid(const PartitionContext &context, size_t att,
+                               const vector<vector<int>> &histograms,
+                               const vector<int> &sizes);
+  size_t size() const;
+  size_t getBegin() const;
+  vector<int> getRows() const;
+  const vector<string> &getGeneralizations() const;
   vector<vector<string>> getResult() const;
   int getNumAllowedCuts();
   void setAllowedCuts(int value, int dim);
   int chooseDimension();
   vector<Partition> splitPartition(int dimension);
-  bool isCutAllowed(int index);
 };
 
 #endif
@@ -0,0 +1,67 @@
+/*! \file partitionSink.cpp
+    \brief Fichero que contiene la clase PartitionSink, destino de las
+           particiones finales del algoritmo Mondrian.
+*/
+
+#include "partitionSink.h"
+
+/*! Constructor de la clase PartitionSink que conserva las particiones
+    finales.
+  \param partitions lista en la que añadir las particiones.
+  \return instancia del destino.
+*/
+PartitionSink::PartitionSink(vector<Partition> &partitions) {
+  this->partitions = &partitions;
+  this->writer = nullptr;
+  this->metrics = nullptr;
+  this->count = 0;
+}
+
+/*! Constructor de la clase PartitionSink que escribe las particiones
+    finales y acumula sus métricas.
+  \param writer fichero en el que escribir el conjunto de datos anonimizado.
+  \param metrics métricas del conjunto de datos anonimizado.
+  \return instancia del destino.
+*/
+PartitionSink::PartitionSink(TableWriter &writer,
+                             MetricsAccumulator &metrics) {
+  this->partitions = nullptr;
+  this->writer = &writer;
+  this->metrics = &metrics;
+  this->count = 0;
+}
+
+/*! Añade una partición final. Sus registros generalizados solo existen
+    mientras se escriben y se acumulan sus métricas.
+  \param partition partición final.
+*/
+void PartitionSink::add(const Partition &partition) {
+  this->count++;
+  if (this->partitions) {
+    this->partitions->emplace_back(partition);
+    return;
+  }
+
+  const vector<vector<string>> records = partition.getResult();
+  this->writer->write(records);
+  this->metrics->add(records);
+}
+
+/*! Añade una partición final ya generalizada, por ejemplo la obtenida por
+    un proceso trabajador. Solo es posible si el destino escribe las
+    particiones.
+  \param records registros generalizados de la partición.
+*/
+void PartitionSink::add(const vector<vector<string>> &records) {
+  if (this->partitions)
+    throw "Error: Generalized partitions can only be written";
+
+  this->count++;
+  this->writer->write(records);
+  this->metrics->add(records);
+}
+
+/*! Devuelve el número de particiones finales añadidas.
+  \return número de particiones.
+*/
+size_t PartitionSink::size() const { return this->count; }
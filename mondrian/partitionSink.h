@@ -0,0 +1,37 @@
+/*! \file partitionSink.h
+    \brief Fichero de cabecera del archivo partitionSink.cpp.
+*/
+
+#ifndef _PARTITIONSINK_H
+#define _PARTITIONSINK_H
+
+using namespace std;
+
+#include "../utilities/metricsAccumulator.h"
+#include "../utilities/writeData.h"
+#include "partition.h"
+#include <vector>
+
+/*! Clase PartitionSink. Destino de las particiones finales del algoritmo
+    Mondrian. Puede conservar las particiones (que solo referencian un rango
+    de registros) o escribir cada una como clase de equivalencia en cuanto
+    se obtiene, acumulando a la vez sus métricas, de modo que el conjunto de
+    datos anonimizado nunca se encuentra completo en memoria.
+*/
+class PartitionSink {
+private:
+  vector<Partition> *partitions;
+  TableWriter *writer;
+  MetricsAccumulator *metrics;
+  size_t count;
+
+public:
+  // Constructors
+  PartitionSink(vector<Partition> &partitions);
+  PartitionSink(TableWriter &writer, MetricsAccumulator &metrics);
+  void add(const Partition &partition);
+  void add(const vector<vector<string>> &records);
+  size_t size() const;
+};
+
+#endif
@@ -0,0 +1,391 @@
+/*! \file processPool.cpp
+    \brief Fichero que contiene el coordinador que reparte el particionado
+           del algoritmo Mondrian entre varios procesos trabajadores, y el
+           bucle principal de cada trabajador.
+*/
+
+#include "processPool.h"
+#include "evaluate.h"
+
+/*! Constructor de la clase ProcessPool. Codifica los qids (y los atributos
+    sensibles, si se utiliza l-diversity o t-closeness), crea los procesos
+    trabajadores y les envía los parámetros del algoritmo.
+  \param processes número de procesos trabajadores.
+  \param dataset conjunto de datos.
+  \param registry registro con las jerarquías de los qids categóricos.
+  \param qids índices de los atributos qids.
+  \param isQidCat indica si cada qid es categórico.
+  \param confAtts índices de los atributos sensibles.
+  \param orderedAtts atributos sensibles con distancia ordenada en
+                     t-closeness.
+  \param K parámetro del modelo de privacidad k-anonymity.
+  \param L parámetro del modelo de privacidad l-diversity.
+  \param T parámetro del modelo de privacidad t-closeness.
+  \return instancia del coordinador.
+*/
+ProcessPool::ProcessPool(size_t processes,
+                         const vector<vector<string>> &dataset,
+                         const HierarchyRegistry &registry,
+                         const vector<int> &qids, const vector<int> &isQidCat,
+                         const vector<int> &confAtts,
+                         const vector<int> &orderedAtts, int K, int L,
+                         long double T) {
+  this->dataset = &dataset;
+  this->qids = qids;
+  // Particiones que se envían a los trabajadores: varias por trabajador
+  processes = max((size_t)1, processes);
+  this->cutoff = max((size_t)1, dataset.size() / (4 * processes));
+
+  // Columnas enviadas: qids y atributos sensibles
+  vector<int> shipped = qids;
+  if (L > 0 || T > 0)
+    shipped.insert(shipped.end(), confAtts.begin(), confAtts.end());
+  this->columns.resize(shipped.size());
+  for (size_t i = 0; i < shipped.size(); i++) {
+    for (const auto &record : dataset)
+      this->columns[i].append(record[shipped[i]]);
+  }
+
+  WorkerSetup setup;
+  setup.K = K;
+  setup.L = L;
+  setup.T = T;
+  setup.isQidCat = isQidCat;
+  for (const Column &column : this->columns)
+    setup.dictionaries.emplace_back(column.getDictionary());
+  for (size_t i = 0; i < qids.size(); i++)
+    setup.hierarchies.emplace_back(isQidCat[i]
+                                       ? registry.getHierarchy(qids[i])
+                                       : vector<vector<string>>());
+  for (size_t i = qids.size(); i < shipped.size(); i++) {
+    setup.ordered.emplace_back(find(orderedAtts.begin(), orderedAtts.end(),
+                                    shipped[i]) != orderedAtts.end());
+    vector<uint32_t> counts(this->columns[i].cardinality(), 0);
+    for (const uint32_t &code : this->columns[i].getCodes())
+      counts[code]++;
+    setup.frequencies.emplace_back(counts);
+  }
+
+  for (size_t i = 0; i < processes; i++) {
+    int tasks[2], results[2];
+    if (pipe(tasks) != 0)
+      throw "Error: Couldn't create worker process";
+    if (pipe(results) != 0) {
+      close(tasks[0]);
+      close(tasks[1]);
+      throw "Error: Couldn't create worker process";
+    }
+
+    const pid_t pid = fork();
+    if (pid == 0) {
+      // Proceso trabajador: solo conserva sus propias tuberías
+      close(tasks[1]);
+      close(results[0]);
+      for (const Worker &worker : this->workers) {
+        close(worker.tasks);
+        close(worker.results);
+      }
+      serveWorker(tasks[0], results[1]);
+      _exit(0);
+    }
+
+    close(tasks[0]);
+    close(results[1]);
+    if (pid < 0) {
+      close(tasks[1]);
+      close(results[0]);
+      throw "Error: Couldn't create worker process";
+    }
+    this->workers.push_back({pid, tasks[1], results[0]});
+  }
+
+  // Un trabajador que termina de forma inesperada no debe terminar el
+  // coordinador al escribir en su tubería
+  this->previousHandler = signal(SIGPIPE, SIG_IGN);
+
+  const Message message = setup.encode();
+  for (const Worker &worker : this->workers)
+    message.send(worker.tasks);
+}
+
+/*! Destructor de la clase ProcessPool. Cierra las tuberías, lo que termina
+    los trabajadores que aún no hayan recibido SHUTDOWN, y espera a que
+    finalicen.
+*/
+ProcessPool::~ProcessPool() {
+  for (const Worker &worker : this->workers) {
+    close(worker.tasks);
+    close(worker.results);
+  }
+  for (const Worker &worker : this->workers)
+    waitpid(worker.pid, nullptr, 0);
+  signal(SIGPIPE, this->previousHandler);
+}
+
+/*! Realiza los primeros cortes sobre una partición, en el mismo orden que
+    el algoritmo secuencial, hasta obtener particiones de menor tamaño que
+    el umbral, que se envían a los trabajadores.
+  \param partition partición a cortar.
+  \param items particiones obtenidas, en orden.
+  \param remote indica si cada partición debe enviarse a un trabajador o si
+                ya es una partición final.
+*/
+void ProcessPool::split(Partition partition, vector<Partition> &items,
+                        vector<bool> &remote) {
+  if (partition.size() < this->cutoff) {
+    items.emplace_back(partition);
+    remote.emplace_back(true);
+    return;
+  }
+
+  if (partition.getNumAllowedCuts() == 0) {
+    items.emplace_back(partition);
+    remote.emplace_back(false);
+    return;
+  }
+
+  int dim = partition.chooseDimension();
+  vector<Partition> pts = partition.splitPartition(dim);
+
+  if (pts.size() == 0) {
+    partition.setAllowedCuts(0, dim);
+    split(partition, items, remote);
+    return;
+  }
+
+  for (const auto &p : pts)
+    split(p, items, remote);
+}
+
+/*! Codifica una partición como tarea para un trabajador.
+  \param id identificador de la tarea.
+  \param partition partición.
+  \return tarea.
+*/
+WorkerTask ProcessPool::createTask(uint32_t id,
+                                   const Partition &partition) const {
+  WorkerTask task;
+  task.id = id;
+  task.generalizations = partition.getGeneralizations();
+  task.codes.reserve(partition.size() * this->columns.size());
+  for (const int &row : partition.getRows()) {
+    for (const Column &column : this->columns)
+      task.codes.emplace_back(column.at(row));
+  }
+  return task;
+}
+
+/*! Generaliza los registros de una clase de equivalencia obtenida por un
+    trabajador.
+  \param rows registros de la tarea en el conjunto de datos.
+  \param generalizations generalización de cada qid en la clase.
+  \param positions posición en la tarea de cada registro de la clase.
+  \return registros generalizados.
+*/
+vector<vector<string>>
+ProcessPool::generalize(const vector<int> &rows,
+                        const vector<string> &generalizations,
+                        const vector<uint32_t> &positions) const {
+  vector<vector<string>> records;
+  records.reserve(positions.size());
+  for (const uint32_t &position : positions) {
+    records.emplace_back((*this->dataset)[rows.at(position)]);
+    for (size_t j = 0; j < this->qids.size(); j++)
+      records.back()[this->qids[j]] = generalizations.at(j);
+  }
+  return records;
+}
+
+/*! Particiona una partición repartiendo el trabajo entre los procesos
+    trabajadores. Cada trabajador recibe una tarea cada vez; las
+    particiones finales se entregan en el mismo orden que con el algoritmo
+    secuencial, por lo que el resultado no depende del número de procesos.
+  \param partition partición inicial.
+  \param sink destino de las particiones finales, que debe escribirlas.
+*/
+void ProcessPool::evaluate(const Partition &partition, PartitionSink &sink) {
+  vector<Partition> items;
+  vector<bool> remote;
+  split(partition, items, remote);
+
+  vector<optional<WorkerResult>> results(items.size());
+  vector<long> running(this->workers.size(), -1);
+  size_t next = 0, emitted = 0;
+  while (true) {
+    // Entregar en orden las particiones finales y los resultados recibidos
+    while (emitted < items.size() && (!remote[emitted] || results[emitted])) {
+      if (!remote[emitted])
+        sink.add(items[emitted]);
+      else {
+        const vector<int> rows = items[emitted].getRows();
+        const WorkerResult &result = *results[emitted];
+        for (size_t i = 0; i < result.generalizations.size(); i++)
+          sink.add(
+              generalize(rows, result.generalizations[i], result.rows[i]));
+        results[emitted].reset();
+      }
+      emitted++;
+    }
+    if (emitted == items.size())
+      break;
+
+    // Enviar una tarea a cada trabajador libre
+    for (size_t w = 0; w < this->workers.size(); w++) {
+      while (next < items.size() && !remote[next])
+        next++;
+      if (next == items.size())
+        break;
+      if (running[w] != -1)
+        continue;
+
+      createTask(next, items[next]).encode().send(this->workers[w].tasks);
+      running[w] = next++;
+    }
+
+    // Esperar el resultado de algún trabajador
+    vector<pollfd> fds;
+    vector<size_t> busy;
+    for (size_t w = 0; w < this->workers.size(); w++) {
+      if (running[w] != -1) {
+        fds.push_back({this->workers[w].results, POLLIN, 0});
+        busy.emplace_back(w);
+      }
+    }
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR)
+        continue;
+      throw "Error: Couldn't receive message from worker process";
+    }
+
+    for (size_t i = 0; i < fds.size(); i++) {
+      if (fds[i].revents == 0)
+        continue;
+
+      Message message;
+      if (!message.receive(fds[i].fd))
+        throw "Error: Worker process failed";
+      if (message.getType() == FAILURE) {
+        cout << message.getString() << endl;
+        throw "Error: Worker process failed";
+      }
+      if (message.getType() != RESULT)
+        throw "Error: Malformed message from worker process";
+
+      WorkerResult result = WorkerResult::decode(message);
+      if (result.id != (uint32_t)running[busy[i]])
+        throw "Error: Malformed message from worker process";
+      results[result.id] = move(result);
+      running[busy[i]] = -1;
+    }
+  }
+
+  const Message shutdown(SHUTDOWN);
+  for (const Worker &worker : this->workers)
+    shutdown.send(worker.tasks);
+}
+
+/*! Envía al coordinador el error que ha detenido a un trabajador. Si el
+    coordinador ya no existe, el error se descarta.
+  \param results descriptor en el que se escriben los resultados.
+  \param error mensaje de error.
+*/
+static void sendFailure(int results, const string &error) {
+  Message failure(FAILURE);
+  failure.putString(error);
+  try {
+    failure.send(results);
+  } catch (const char *e) {
+  }
+}
+
+/*! Bucle principal de un proceso trabajador. Recibe los parámetros del
+    algoritmo y, a continuación, particiona cada tarea recibida con el
+    algoritmo secuencial y devuelve sus clases de equivalencia, hasta
+    recibir SHUTDOWN. Los qids ocupan las primeras columnas de cada
+    registro recibido y los atributos sensibles las siguientes.
+  \param tasks descriptor del que se leen los mensajes del coordinador.
+  \param results descriptor en el que se escriben los resultados.
+*/
+void serveWorker(int tasks, int results) {
+  try {
+    WorkerSetup setup;
+    vector<int> qids, confAtts;
+    map<int, Tree> trees;
+    TClosenessEvaluator sensitive;
+    vector<vector<int>> sensitiveCodes;
+
+    Message message;
+    while (message.receive(tasks)) {
+      if (message.getType() == SHUTDOWN)
+        return;
+
+      if (message.getType() == SETUP) {
+        setup = WorkerSetup::decode(message);
+        const size_t nQids = setup.isQidCat.size();
+        qids.resize(nQids);
+        iota(qids.begin(), qids.end(), 0);
+        confAtts.resize(setup.frequencies.size());
+        iota(confAtts.begin(), confAtts.end(), nQids);
+        for (size_t i = 0; i < nQids; i++) {
+          if (setup.isQidCat[i])
+            trees[i] = Tree(setup.hierarchies[i]);
+        }
+
+        // Distribución global de los atributos sensibles
+        vector<map<string, int>> frequencies(confAtts.size());
+        for (size_t att = 0; att < confAtts.size(); att++) {
+          const vector<string> &values = setup.dictionaries[confAtts[att]];
+          for (size_t code = 0; code < values.size(); code++)
+            frequencies[att][values[code]] += setup.frequencies[att][code];
+        }
+        const vector<bool> ordered(setup.ordered.begin(), setup.ordered.end());
+        sensitive = TClosenessEvaluator(frequencies, ordered);
+        sensitiveCodes.assign(confAtts.size(), {});
+        for (size_t att = 0; att < confAtts.size(); att++) {
+          for (const string &value : setup.dictionaries[confAtts[att]])
+            sensitiveCodes[att].emplace_back(sensitive.encode(att, value));
+        }
+        continue;
+      }
+
+      if (message.getType() != TASK)
+        throw "Error: Malformed message from coordinator process";
+
+      // Decodificar los registros de la tarea
+      const WorkerTask task = WorkerTask::decode(message);
+      const size_t columns = setup.dictionaries.size();
+      vector<vector<string>> data;
+      vector<vector<int>> codes(confAtts.size());
+      for (size_t i = 0; i + columns <= task.codes.size(); i += columns) {
+        vector<string> row;
+        row.reserve(columns);
+        for (size_t col = 0; col < columns; col++)
+          row.emplace_back(setup.dictionaries[col].at(task.codes[i + col]));
+        data.emplace_back(move(row));
+        for (size_t att = 0; att < confAtts.size(); att++)
+          codes[att].emplace_back(
+              sensitiveCodes[att][task.codes[i + confAtts[att]]]);
+      }
+
+      Partition partition(data, task.generalizations, qids, setup.isQidCat,
+                          trees, confAtts, sensitive.withCodes(move(codes)),
+                          setup.K, setup.L, setup.T);
+      vector<Partition> classes;
+      PartitionSink sink(classes);
+      evaluate(partition, sink);
+
+      WorkerResult result;
+      result.id = task.id;
+      for (const Partition &p : classes) {
+        result.generalizations.emplace_back(p.getGeneralizations());
+        const vector<int> rows = p.getRows();
+        result.rows.emplace_back(rows.begin(), rows.end());
+      }
+      result.encode().send(results);
+    }
+  } catch (const char *e) {
+    sendFailure(results, e);
+  } catch (const exception &e) {
+    sendFailure(results, e.what());
+  }
+}
@@ -0,0 +1,72 @@
+/*! \file processPool.h
+    \brief Fichero de cabecera del archivo processPool.cpp.
+*/
+
+#ifndef _PROCESSPOOL_H
+#define _PROCESSPOOL_H
+
+using namespace std;
+
+#include "../utilities/hierarchyRegistry.h"
+#include "../utilities/table.h"
+#include "../utilities/tCloseness.h"
+#include "partition.h"
+#include "partitionSink.h"
+#include "protocol.h"
+#include <csignal>
+#include <map>
+#include <optional>
+#include <poll.h>
+#include <string>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+/*! Clase ProcessPool. Coordinador que reparte una ejecución de Mondrian
+    entre varios procesos trabajadores. El coordinador realiza los primeros
+    cortes y envía cada partición resultante, con sus registros codificados,
+    a un trabajador, que la particiona de forma independiente y devuelve
+    sus clases de equivalencia. La comunicación utiliza únicamente los
+    mensajes de protocol.h sobre un par de tuberías por trabajador, de modo
+    que el mismo coordinador pueda dirigir trabajadores remotos.
+*/
+class ProcessPool {
+private:
+  /*! Estructura Worker. Proceso trabajador y descriptores de sus tuberías
+      de tareas y de resultados.
+   */
+  struct Worker {
+    pid_t pid;
+    int tasks, results;
+  };
+
+  vector<Worker> workers;
+  const vector<vector<string>> *dataset;
+  vector<int> qids;
+  vector<Column> columns;
+  size_t cutoff;
+  void (*previousHandler)(int);
+
+  void split(Partition partition, vector<Partition> &items,
+             vector<bool> &remote);
+  WorkerTask createTask(uint32_t id, const Partition &partition) const;
+  vector<vector<string>> generalize(const vector<int> &rows,
+                                    const vector<string> &generalizations,
+                                    const vector<uint32_t> &positions) const;
+
+public:
+  // Constructor
+  ProcessPool(size_t processes, const vector<vector<string>> &dataset,
+              const HierarchyRegistry &registry, const vector<int> &qids,
+              const vector<int> &isQidCat, const vector<int> &confAtts,
+              const vector<int> &orderedAtts, int K, int L, long double T);
+  ProcessPool(const ProcessPool &) = delete;
+  ProcessPool &operator=(const ProcessPool &) = delete;
+  ~ProcessPool();
+  void evaluate(const Partition &partition, PartitionSink &sink);
+};
+
+void serveWorker(int tasks, int results);
+
+#endif
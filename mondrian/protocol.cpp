@@ -0,0 +1,327 @@
+/*! \file protocol.cpp
+    \brief Fichero que contiene el protocolo de mensajes entre el
+           coordinador de Mondrian y sus procesos trabajadores.
+*/
+
+#include "protocol.h"
+#include <cerrno>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <unistd.h>
+
+/*! Escribe un bloque de bytes completo en un descriptor de fichero.
+  \param fd descriptor de fichero.
+  \param data bytes a escribir.
+  \param bytes número de bytes.
+*/
+static void writeBytes(int fd, const char *data, size_t bytes) {
+  while (bytes > 0) {
+    const ssize_t written = write(fd, data, bytes);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written <= 0)
+      throw "Error: Couldn't send message to worker process";
+    data += written;
+    bytes -= written;
+  }
+}
+
+/*! Lee un bloque de bytes completo de un descriptor de fichero.
+  \param fd descriptor de fichero.
+  \param data destino de los bytes.
+  \param bytes número de bytes.
+  \return 1 si se ha leído el bloque, 0 si el otro extremo ha cerrado el
+          descriptor antes del primer byte.
+*/
+static bool readBytes(int fd, char *data, size_t bytes) {
+  size_t total = 0;
+  while (total < bytes) {
+    const ssize_t count = read(fd, data + total, bytes - total);
+    if (count < 0 && errno == EINTR)
+      continue;
+    if (count == 0 && total == 0)
+      return false;
+    if (count <= 0)
+      throw "Error: Couldn't receive message from worker process";
+    total += count;
+  }
+  return true;
+}
+
+/*! Constructor por defecto de la clase Message (mensaje vacío).
+  \return instancia del mensaje.
+*/
+Message::Message() : Message(0) {}
+
+/*! Constructor de la clase Message.
+  \param type tipo del mensaje.
+  \return instancia del mensaje.
+*/
+Message::Message(uint32_t type) {
+  this->type = type;
+  this->offset = 0;
+}
+
+/*! Devuelve el tipo del mensaje.
+  \return tipo del mensaje.
+*/
+uint32_t Message::getType() const { return this->type; }
+
+/*! Añade un entero sin signo a la carga.
+  \param value entero.
+*/
+void Message::putUint(uint32_t value) {
+  for (int i = 0; i < 4; i++)
+    this->payload.push_back((char)((value >> (8 * i)) & 0xff));
+}
+
+/*! Añade un entero con signo a la carga.
+  \param value entero.
+*/
+void Message::putInt(int value) { putUint((uint32_t)value); }
+
+/*! Añade una cadena a la carga.
+  \param value cadena.
+*/
+void Message::putString(const string &value) {
+  putUint(value.size());
+  this->payload += value;
+}
+
+/*! Añade una lista de enteros sin signo a la carga.
+  \param values enteros.
+*/
+void Message::putUints(const vector<uint32_t> &values) {
+  putUint(values.size());
+  for (const uint32_t &value : values)
+    putUint(value);
+}
+
+/*! Añade una lista de enteros con signo a la carga.
+  \param values enteros.
+*/
+void Message::putInts(const vector<int> &values) {
+  putUint(values.size());
+  for (const int &value : values)
+    putInt(value);
+}
+
+/*! Añade una lista de cadenas a la carga.
+  \param values cadenas.
+*/
+void Message::putStrings(const vector<string> &values) {
+  putUint(values.size());
+  for (const string &value : values)
+    putString(value);
+}
+
+/*! Extrae un bloque de bytes de la carga.
+  \param bytes número de bytes.
+  \return puntero al inicio del bloque.
+*/
+const char *Message::take(size_t bytes) {
+  if (this->payload.size() - this->offset < bytes)
+    throw "Error: Malformed message from worker process";
+  const char *data = this->payload.data() + this->offset;
+  this->offset += bytes;
+  return data;
+}
+
+/*! Extrae un entero sin signo de la carga.
+  \return entero.
+*/
+uint32_t Message::getUint() {
+  const unsigned char *data = (const unsigned char *)take(4);
+  uint32_t value = 0;
+  for (int i = 0; i < 4; i++)
+    value |= (uint32_t)data[i] << (8 * i);
+  return value;
+}
+
+/*! Extrae un entero con signo de la carga.
+  \return entero.
+*/
+int Message::getInt() { return (int)getUint(); }
+
+/*! Extrae una cadena de la carga.
+  \return cadena.
+*/
+string Message::getString() {
+  const uint32_t size = getUint();
+  return string(take(size), size);
+}
+
+/*! Extrae una lista de enteros sin signo de la carga.
+  \return enteros.
+*/
+vector<uint32_t> Message::getUints() {
+  vector<uint32_t> values(getUint());
+  for (uint32_t &value : values)
+    value = getUint();
+  return values;
+}
+
+/*! Extrae una lista de enteros con signo de la carga.
+  \return enteros.
+*/
+vector<int> Message::getInts() {
+  vector<int> values(getUint());
+  for (int &value : values)
+    value = getInt();
+  return values;
+}
+
+/*! Extrae una lista de cadenas de la carga.
+  \return cadenas.
+*/
+vector<string> Message::getStrings() {
+  vector<string> values(getUint());
+  for (string &value : values)
+    value = getString();
+  return values;
+}
+
+/*! Envía el mensaje, con su cabecera, por un descriptor de fichero.
+  \param fd descriptor de fichero.
+*/
+void Message::send(int fd) const {
+  Message header;
+  header.putUint(this->type);
+  const uint64_t size = this->payload.size();
+  header.putUint((uint32_t)size);
+  header.putUint((uint32_t)(size >> 32));
+
+  writeBytes(fd, header.payload.data(), header.payload.size());
+  writeBytes(fd, this->payload.data(), this->payload.size());
+}
+
+/*! Recibe un mensaje completo por un descriptor de fichero.
+  \param fd descriptor de fichero.
+  \return 1 si se ha recibido un mensaje, 0 si el otro extremo ha cerrado
+          el descriptor.
+*/
+bool Message::receive(int fd) {
+  Message header;
+  header.payload.resize(12);
+  if (!readBytes(fd, &header.payload[0], header.payload.size()))
+    return false;
+
+  this->type = header.getUint();
+  uint64_t size = header.getUint();
+  size |= (uint64_t)header.getUint() << 32;
+  this->payload.resize(size);
+  this->offset = 0;
+  if (size > 0 && !readBytes(fd, &this->payload[0], size))
+    throw "Error: Couldn't receive message from worker process";
+  return true;
+}
+
+/*! Codifica los parámetros de un trabajador como mensaje SETUP.
+  \return mensaje.
+*/
+Message WorkerSetup::encode() const {
+  Message message(SETUP);
+  message.putInt(this->K);
+  message.putInt(this->L);
+  stringstream T;
+  T << setprecision(numeric_limits<long double>::max_digits10) << this->T;
+  message.putString(T.str());
+  message.putInts(this->isQidCat);
+  message.putInts(this->ordered);
+
+  message.putUint(this->dictionaries.size());
+  for (const auto &dictionary : this->dictionaries)
+    message.putStrings(dictionary);
+  message.putUint(this->hierarchies.size());
+  for (const auto &hierarchy : this->hierarchies) {
+    message.putUint(hierarchy.size());
+    for (const auto &row : hierarchy)
+      message.putStrings(row);
+  }
+  message.putUint(this->frequencies.size());
+  for (const auto &counts : this->frequencies)
+    message.putUints(counts);
+
+  return message;
+}
+
+/*! Decodifica un mensaje SETUP.
+  \param message mensaje.
+  \return parámetros del trabajador.
+*/
+WorkerSetup WorkerSetup::decode(Message &message) {
+  WorkerSetup setup;
+  setup.K = message.getInt();
+  setup.L = message.getInt();
+  setup.T = stold(message.getString());
+  setup.isQidCat = message.getInts();
+  setup.ordered = message.getInts();
+
+  setup.dictionaries.resize(message.getUint());
+  for (auto &dictionary : setup.dictionaries)
+    dictionary = message.getStrings();
+  setup.hierarchies.resize(message.getUint());
+  for (auto &hierarchy : setup.hierarchies) {
+    hierarchy.resize(message.getUint());
+    for (auto &row : hierarchy)
+      row = message.getStrings();
+  }
+  setup.frequencies.resize(message.getUint());
+  for (auto &counts : setup.frequencies)
+    counts = message.getUints();
+
+  return setup;
+}
+
+/*! Codifica una tarea como mensaje TASK.
+  \return mensaje.
+*/
+Message WorkerTask::encode() const {
+  Message message(TASK);
+  message.putUint(this->id);
+  message.putStrings(this->generalizations);
+  message.putUints(this->codes);
+  return message;
+}
+
+/*! Decodifica un mensaje TASK.
+  \param message mensaje.
+  \return tarea.
+*/
+WorkerTask WorkerTask::decode(Message &message) {
+  WorkerTask task;
+  task.id = message.getUint();
+  task.generalizations = message.getStrings();
+  task.codes = message.getUints();
+  return task;
+}
+
+/*! Codifica el resultado de una tarea como mensaje RESULT.
+  \return mensaje.
+*/
+Message WorkerResult::encode() const {
+  Message message(RESULT);
+  message.putUint(this->id);
+  message.putUint(this->generalizations.size());
+  for (size_t i = 0; i < this->generalizations.size(); i++) {
+    message.putStrings(this->generalizations[i]);
+    message.putUints(this->rows[i]);
+  }
+  return message;
+}
+
+/*! Decodifica un mensaje RESULT.
+  \param message mensaje.
+  \return resultado de la tarea.
+*/
+WorkerResult WorkerResult::decode(Message &message) {
+  WorkerResult result;
+  result.id = message.getUint();
+  const uint32_t classes = message.getUint();
+  for (uint32_t i = 0; i < classes; i++) {
+    result.generalizations.emplace_back(message.getStrings());
+    result.rows.emplace_back(message.getUints());
+  }
+  return result;
+}
@@ -0,0 +1,118 @@
+/*! \file protocol.h
+    \brief Fichero de cabecera del archivo protocol.cpp.
+*/
+
+#ifndef _PROTOCOL_H
+#define _PROTOCOL_H
+
+using namespace std;
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*! Tipos de mensaje del protocolo entre el coordinador de Mondrian y sus
+    procesos trabajadores. Cada mensaje consta de una cabecera, con el tipo
+    (4 bytes) y la longitud de la carga (8 bytes), seguida de la carga. Los
+    enteros se codifican sin signo en little-endian (los enteros con signo
+    en complemento a dos), las cadenas como su longitud (4 bytes) seguida
+    de sus bytes y las listas como su número de elementos (4 bytes) seguido
+    de los elementos, por lo que el protocolo no depende de la arquitectura
+    de cada extremo.
+
+    - SETUP (coordinador -> trabajador, una vez): K, L, T (cadena decimal),
+      tipo de cada qid, si cada atributo sensible utiliza la distancia
+      ordenada, diccionario de cada qid y de cada atributo sensible,
+      jerarquía de cada qid (vacía si es numérico) y frecuencia de cada
+      código de los atributos sensibles en el conjunto de datos completo.
+    - TASK (coordinador -> trabajador): identificador, generalización de
+      cada qid y, por cada registro, el código de cada qid seguido del
+      código de cada atributo sensible.
+    - RESULT (trabajador -> coordinador): identificador y, por cada clase
+      de equivalencia, la generalización de cada qid y la posición en la
+      tarea de cada uno de sus registros, en orden.
+    - FAILURE (trabajador -> coordinador): mensaje de error.
+    - SHUTDOWN (coordinador -> trabajador): sin carga.
+*/
+enum MessageType : uint32_t {
+  SETUP = 1,
+  TASK = 2,
+  RESULT = 3,
+  FAILURE = 4,
+  SHUTDOWN = 5
+};
+
+/*! Clase Message. Mensaje del protocolo: se construye añadiendo valores a
+    su carga y se lee extrayéndolos en el mismo orden.
+*/
+class Message {
+private:
+  uint32_t type;
+  string payload;
+  size_t offset;
+
+  const char *take(size_t bytes);
+
+public:
+  // Constructors
+  Message();
+  Message(uint32_t type);
+  uint32_t getType() const;
+  void putUint(uint32_t value);
+  void putInt(int value);
+  void putString(const string &value);
+  void putUints(const vector<uint32_t> &values);
+  void putInts(const vector<int> &values);
+  void putStrings(const vector<string> &values);
+  uint32_t getUint();
+  int getInt();
+  string getString();
+  vector<uint32_t> getUints();
+  vector<int> getInts();
+  vector<string> getStrings();
+  void send(int fd) const;
+  bool receive(int fd);
+};
+
+/*! Estructura WorkerSetup. Parámetros del algoritmo y datos compartidos por
+    todas las tareas de un trabajador (mensaje SETUP).
+*/
+struct WorkerSetup {
+  int K, L;
+  long double T;
+  vector<int> isQidCat;
+  vector<int> ordered;
+  vector<vector<string>> dictionaries;
+  vector<vector<vector<string>>> hierarchies;
+  vector<vector<uint32_t>> frequencies;
+
+  Message encode() const;
+  static WorkerSetup decode(Message &message);
+};
+
+/*! Estructura WorkerTask. Partición que debe particionar un trabajador
+    (mensaje TASK). Los códigos de cada registro son consecutivos: primero
+    los de los qids y después los de los atributos sensibles.
+*/
+struct WorkerTask {
+  uint32_t id;
+  vector<string> generalizations;
+  vector<uint32_t> codes;
+
+  Message encode() const;
+  static WorkerTask decode(Message &message);
+};
+
+/*! Estructura WorkerResult. Clases de equivalencia obtenidas por un
+    trabajador a partir de una tarea (mensaje RESULT).
+*/
+struct WorkerResult {
+  uint32_t id;
+  vector<vector<string>> generalizations;
+  vector<vector<uint32_t>> rows;
+
+  Message encode() const;
+  static WorkerResult decode(Message &message);
+};
+
+#endif
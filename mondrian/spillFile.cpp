@@ -0,0 +1,92 @@
+/*! \file spillFile.cpp
+    \brief Fichero que contiene las clases SpillFile y SpillReader, que
+           permiten volcar a disco los registros codificados de una
+           partición y recorrerlos posteriormente.
+*/
+
+#include "spillFile.h"
+
+/*! Constructor de la clase SpillFile. Crea el fichero, vacío y abierto para
+    añadir registros.
+  \param path ruta del fichero.
+  \param columns número de atributos de cada registro.
+  \return instancia del fichero.
+*/
+SpillFile::SpillFile(const string &path, size_t columns) {
+  this->path = path;
+  this->columns = columns;
+  this->rows = 0;
+  this->output.open(path, ios::binary | ios::trunc);
+  if (!this->output.is_open())
+    throw "Error: Couldn't create spill file";
+}
+
+/*! Destructor de la clase SpillFile. Borra el fichero.
+*/
+SpillFile::~SpillFile() {
+  if (this->output.is_open())
+    this->output.close();
+  error_code error;
+  std::filesystem::remove(this->path, error);
+}
+
+/*! Añade un registro al final del fichero.
+  \param record código de cada atributo del registro.
+*/
+void SpillFile::append(const vector<uint32_t> &record) {
+  this->output.write(reinterpret_cast<const char *>(record.data()),
+                     this->columns * sizeof(uint32_t));
+  this->rows++;
+}
+
+/*! Termina la escritura del fichero, de modo que pueda recorrerse.
+*/
+void SpillFile::close() {
+  this->output.close();
+  if (this->output.fail())
+    throw "Error: Couldn't write spill file";
+}
+
+/*! Devuelve el número de registros del fichero.
+  \return número de registros.
+*/
+size_t SpillFile::size() const { return this->rows; }
+
+/*! Devuelve el número de atributos de cada registro.
+  \return número de atributos.
+*/
+size_t SpillFile::numColumns() const { return this->columns; }
+
+/*! Devuelve la ruta del fichero.
+  \return ruta del fichero.
+*/
+const string &SpillFile::getPath() const { return this->path; }
+
+/*! Constructor de la clase SpillReader.
+  \param file fichero a recorrer, ya cerrado.
+  \return instancia del lector.
+*/
+SpillReader::SpillReader(const SpillFile &file) {
+  this->columns = file.numColumns();
+  this->remaining = file.size();
+  this->input.open(file.getPath(), ios::binary);
+  if (!this->input.is_open())
+    throw "Error: Couldn't read spill file";
+}
+
+/*! Lee el siguiente registro del fichero.
+  \param record código de cada atributo del registro leído.
+  \return 1 si se ha leído un registro, 0 si no quedan registros.
+*/
+bool SpillReader::next(vector<uint32_t> &record) {
+  if (this->remaining == 0)
+    return false;
+
+  record.resize(this->columns);
+  this->input.read(reinterpret_cast<char *>(record.data()),
+                   this->columns * sizeof(uint32_t));
+  if (!this->input)
+    throw "Error: Couldn't read spill file";
+  this->remaining--;
+  return true;
+}
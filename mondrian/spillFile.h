@@ -0,0 +1,55 @@
+/*! \file spillFile.h
+    \brief Fichero de cabecera del archivo spillFile.cpp.
+*/
+
+#ifndef _SPILLFILE_H
+#define _SPILLFILE_H
+
+using namespace std;
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*! Clase SpillFile. Fichero temporal que contiene registros codificados: cada
+    registro ocupa un entero de 32 bits por atributo (el código del valor en
+    el diccionario de su columna). Los registros se añaden al final y, una
+    vez cerrado, el fichero se recorre con SpillReader. El fichero se borra
+    al destruirse la instancia, por lo que no puede copiarse.
+*/
+class SpillFile {
+private:
+  string path;
+  size_t columns, rows;
+  ofstream output;
+
+public:
+  // Constructor
+  SpillFile(const string &path, size_t columns);
+  SpillFile(const SpillFile &) = delete;
+  SpillFile &operator=(const SpillFile &) = delete;
+  ~SpillFile();
+  void append(const vector<uint32_t> &record);
+  void close();
+  size_t size() const;
+  size_t numColumns() const;
+  const string &getPath() const;
+};
+
+/*! Clase SpillReader. Recorre secuencialmente los registros de un fichero
+    temporal ya cerrado.
+*/
+class SpillReader {
+private:
+  ifstream input;
+  size_t columns, remaining;
+
+public:
+  // Constructor
+  SpillReader(const SpillFile &file);
+  bool next(vector<uint32_t> &record);
+};
+
+#endif
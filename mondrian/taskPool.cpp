@@ -0,0 +1,147 @@
+/*! \file taskPool.cpp
+    \brief Fichero que contiene el conjunto de hilos que realiza en paralelo
+           el particionado del algoritmo Mondrian.
+*/
+
+#include "taskPool.h"
+#include "evaluate.h"
+
+/*! Constructor de la clase TaskPool.
+  \param threads número de hilos.
+  \param cutoff número de registros por debajo del cual una partición se
+                particiona de forma secuencial.
+  \return instancia del conjunto de hilos.
+*/
+TaskPool::TaskPool(size_t threads, size_t cutoff) {
+  for (size_t i = 0; i < max((size_t)1, threads); i++)
+    this->workers.emplace_back(make_unique<Worker>());
+  this->pending = 0;
+  this->cutoff = cutoff;
+}
+
+/*! Añade una tarea al final de la cola de un hilo.
+  \param id identificador del hilo.
+  \param partition partición a cortar.
+*/
+void TaskPool::push(size_t id, const Partition &partition) {
+  Worker &worker = *this->workers[id];
+  this->pending++;
+  lock_guard<mutex> guard(worker.lock);
+  worker.tasks.emplace_back(partition);
+}
+
+/*! Extrae la última tarea de la cola de un hilo.
+  \param id identificador del hilo.
+  \return tarea, o ninguna si la cola está vacía.
+*/
+optional<Partition> TaskPool::pop(size_t id) {
+  Worker &worker = *this->workers[id];
+  lock_guard<mutex> guard(worker.lock);
+  if (worker.tasks.empty())
+    return nullopt;
+
+  optional<Partition> task(move(worker.tasks.back()));
+  worker.tasks.pop_back();
+  return task;
+}
+
+/*! Roba la primera tarea de la cola de otro hilo. Las primeras tareas son
+    las más antiguas y, por tanto, las particiones de mayor tamaño.
+  \param id identificador del hilo que roba la tarea.
+  \return tarea, o ninguna si todas las colas están vacías.
+*/
+optional<Partition> TaskPool::steal(size_t id) {
+  for (size_t i = 1; i < this->workers.size(); i++) {
+    Worker &victim = *this->workers[(id + i) % this->workers.size()];
+    lock_guard<mutex> guard(victim.lock);
+    if (victim.tasks.empty())
+      continue;
+
+    optional<Partition> task(move(victim.tasks.front()));
+    victim.tasks.pop_front();
+    return task;
+  }
+
+  return nullopt;
+}
+
+/*! Particiona una partición. El hilo continúa con la primera partición
+    resultante de cada corte y añade el resto a su cola.
+  \param id identificador del hilo.
+  \param partition partición a cortar.
+*/
+void TaskPool::process(size_t id, Partition partition) {
+  PartitionSink sink(this->workers[id]->result);
+  while (true) {
+    if (partition.size() < this->cutoff) {
+      ::evaluate(partition, sink);
+      return;
+    }
+
+    if (partition.getNumAllowedCuts() == 0) {
+      sink.add(partition);
+      return;
+    }
+
+    int dim = partition.chooseDimension();
+    vector<Partition> pts = partition.splitPartition(dim);
+
+    if (pts.size() == 0) {
+      partition.setAllowedCuts(0, dim);
+      continue;
+    }
+
+    for (size_t i = 1; i < pts.size(); i++)
+      push(id, pts[i]);
+    partition = pts[0];
+  }
+}
+
+/*! Bucle principal de un hilo. Finaliza cuando no quedan tareas pendientes
+    ni en ejecución.
+  \param id identificador del hilo.
+*/
+void TaskPool::run(size_t id) {
+  while (this->pending > 0) {
+    optional<Partition> task = pop(id);
+    if (!task)
+      task = steal(id);
+    if (!task) {
+      this_thread::yield();
+      continue;
+    }
+
+    process(id, move(*task));
+    this->pending--;
+  }
+}
+
+/*! Particiona en paralelo una partición. Las particiones finales se unen
+    ordenadas según su posición en la permutación compartida, que coincide
+    con el orden en el que las obtiene el algoritmo secuencial, de modo que
+    el resultado no depende del número de hilos.
+  \param partition partición inicial.
+  \return particiones finales.
+*/
+vector<Partition> TaskPool::evaluate(const Partition &partition) {
+  push(0, partition);
+
+  vector<thread> threads;
+  for (size_t i = 1; i < this->workers.size(); i++)
+    threads.emplace_back([this, i]() { run(i); });
+  run(0);
+  for (thread &worker : threads)
+    worker.join();
+
+  vector<Partition> result;
+  for (const auto &worker : this->workers) {
+    result.insert(result.end(), worker->result.begin(), worker->result.end());
+    worker->result.clear();
+  }
+  sort(result.begin(), result.end(),
+       [](const Partition &a, const Partition &b) {
+         return a.getBegin() < b.getBegin();
+       });
+
+  return result;
+}
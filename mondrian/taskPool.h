@@ -0,0 +1,52 @@
+/*! \file taskPool.h
+    \brief Fichero de cabecera del archivo taskPool.cpp.
+*/
+
+#ifndef _TASKPOOL_H
+#define _TASKPOOL_H
+
+using namespace std;
+
+#include "../utilities/sweep.h"
+#include "partition.h"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/*! Clase TaskPool. Conjunto de hilos que particiona en paralelo el conjunto
+    de datos. Cada partición pendiente de cortar es una tarea; cada hilo
+    extrae tareas del final de su propia cola y, cuando la vacía, roba
+    tareas del principio de las colas del resto de hilos. Las particiones
+    pequeñas se particionan de forma secuencial en el hilo que las extrae.
+*/
+class TaskPool {
+private:
+  /*! Estructura Worker. Cola de tareas y particiones finales de un hilo.
+   */
+  struct Worker {
+    mutex lock;
+    deque<Partition> tasks;
+    vector<Partition> result;
+  };
+
+  vector<unique_ptr<Worker>> workers;
+  atomic<size_t> pending;
+  size_t cutoff;
+
+  void push(size_t id, const Partition &partition);
+  optional<Partition> pop(size_t id);
+  optional<Partition> steal(size_t id);
+  void process(size_t id, Partition partition);
+  void run(size_t id);
+
+public:
+  // Constructor
+  TaskPool(size_t threads, size_t cutoff);
+  vector<Partition> evaluate(const Partition &partition);
+};
+
+#endif
@@ -11,7 +11,7 @@
   \param tree árbol jerárquico del atributo.
   \return valor parcial de la métrica NCP.
 */
-long double calculateCatNCP(const vector<string> atts, Tree tree) {
+long double calculateCatNCP(const vector<string> &atts, const Tree &tree) {
   // Calculate NCP fot qid values
   long double card = tree.getNCP(atts);
   if (card == 1)
@@ -127,7 +127,8 @@ bool sortMinSplit(string a, string b) {
 */
 vector<long double> calculateNCPS(vector<vector<vector<string>>> clusters,
                                   vector<double> weights, vector<int> allQids,
-                                  vector<int> numQids, map<int, Tree> trees) {
+                                  vector<int> numQids,
+                                  const map<int, Tree> &trees) {
   vector<long double> cncps;
 
   // Calculate numerical attibute global maximum and minimum values
@@ -189,8 +190,8 @@ vector<long double> calculateNCPS(vector<vector<vector<string>>> clusters,
                weights[i];
       } else {
         // Categorical attributes
-        long double aux =
-            calculateCatNCP(tcluster[allQids[i]], trees[allQids[i]]);
+        const Tree &tree = findTree(trees, allQids[i]);
+        long double aux = calculateCatNCP(tcluster[allQids[i]], tree);
         if (aux == -1)
           continue;
         ncp += aux * weights[i];
@@ -211,8 +212,9 @@ vector<long double> calculateNCPS(vector<vector<vector<string>>> clusters,
   \param cncps valores de la métrica NCP.
   \return valor de la métrica GCP.
 */
-void calculateGCP(vector<vector<vector<string>>> clusters, int numRecords,
-                  vector<int> qids, vector<long double> cncps) {
+long double calculateGCP(vector<vector<vector<string>>> clusters,
+                         int numRecords, vector<int> qids,
+                         vector<long double> cncps) {
 
   long double gcp = 0;
   for (size_t i = 0; i < clusters.size(); i++) {
@@ -223,4 +225,6 @@ void calculateGCP(vector<vector<vector<string>>> clusters, int numRecords,
   // Show only 3 decimals
   cout << "\t* GCP: ";
   cout << fixed << setprecision(3) << gcp << endl;
+
+  return gcp;
 }
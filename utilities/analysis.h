@@ -17,11 +17,15 @@ using namespace std;
 
 long double calculateNumNCP(const vector<string> atts, long double globalMax,
                             long double globalMin);
-long double calculateCatNCP(const vector<string> atts, Tree tree);
+long double calculateCatNCP(const vector<string> &atts, const Tree &tree);
+bool sortMaxSplit(string a, string b);
+bool sortMinSplit(string a, string b);
 vector<long double> calculateNCPS(vector<vector<vector<string>>> clusters,
                                   vector<double> weights, vector<int> allQids,
-                                  vector<int> numQids, map<int, Tree> trees);
-void calculateGCP(vector<vector<vector<string>>> clusters, int numRecords,
-                  vector<int> qids, vector<long double> cncps);
+                                  vector<int> numQids,
+                                  const map<int, Tree> &trees);
+long double calculateGCP(vector<vector<vector<string>>> clusters,
+                         int numRecords, vector<int> qids,
+                         vector<long double> cncps);
 
 #endif
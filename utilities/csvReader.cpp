@@ -0,0 +1,304 @@
+/*! \file csvReader.cpp
+    \brief Fichero que contiene el lector de ficheros csv. El fichero se
+           proyecta en memoria y sus celdas se recorren como vistas
+           (string_view) sin reservar memoria por celda.
+*/
+
+#include "csvReader.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+
+/*! Constructor. Proyecta el fichero en memoria.
+  \param filename ruta del fichero.
+*/
+MappedFile::MappedFile(const string &filename) {
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+    throw "Error reading file";
+
+  struct stat st;
+  if (fstat(fd, &st) == -1) {
+    close(fd);
+    throw "Error reading file";
+  }
+
+  this->length = st.st_size;
+  if (this->length > 0) {
+    void *addr = mmap(NULL, this->length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      close(fd);
+      throw "Error reading file";
+    }
+    madvise(addr, this->length, MADV_SEQUENTIAL);
+    this->data = (const char *)addr;
+  }
+
+  // La proyección se mantiene aunque se cierre el descriptor
+  close(fd);
+}
+
+//! Destructor. Libera la proyección del fichero.
+MappedFile::~MappedFile() {
+  if (this->data)
+    munmap((void *)this->data, this->length);
+}
+
+/*! Devuelve un puntero al inicio del fichero.
+  \return puntero al primer byte.
+*/
+const char *MappedFile::begin() const { return this->data; }
+
+/*! Devuelve un puntero al final del fichero.
+  \return puntero al byte siguiente al último.
+*/
+const char *MappedFile::end() const { return this->data + this->length; }
+
+/*! Devuelve el tamaño del fichero.
+  \return número de bytes.
+*/
+size_t MappedFile::size() const { return this->length; }
+
+/*! Divide una línea en celdas con el mismo criterio que getline: un
+    delimitador final no genera una celda vacía adicional.
+  \param line línea a dividir.
+  \param delimiter delimitador de celdas.
+  \param cells vistas de cada una de las celdas (se sobreescribe).
+*/
+void splitLine(string_view line, const char delimiter,
+               vector<string_view> &cells) {
+  cells.clear();
+  size_t start = 0;
+  while (start < line.size()) {
+    size_t pos = line.find(delimiter, start);
+    if (pos == string_view::npos) {
+      cells.emplace_back(line.substr(start));
+      return;
+    }
+    cells.emplace_back(line.substr(start, pos - start));
+    start = pos + 1;
+  }
+}
+
+/*! Calcula el número de hilos con el que procesar un fichero. Los ficheros
+    pequeños se procesan en un único hilo, ya que el coste de crear los
+    hilos superaría al de su lectura.
+  \param bytes tamaño del fichero.
+  \return número de hilos.
+*/
+size_t parseThreads(const size_t bytes) {
+  const size_t minChunk = 1 << 20; // 1 MB
+  size_t threads = max(1u, thread::hardware_concurrency());
+  return max((size_t)1, min(threads, bytes / minChunk));
+}
+
+/*! Divide un rango de bytes en fragmentos de tamaño similar, de modo que
+    cada fragmento comience al inicio de una línea.
+  \param begin inicio del rango.
+  \param end final del rango.
+  \param parts número de fragmentos deseado.
+  \return fragmentos, en el orden del fichero.
+*/
+vector<string_view> splitChunks(const char *begin, const char *end,
+                                const size_t parts) {
+  vector<string_view> chunks;
+  const size_t step = (end - begin) / max((size_t)1, parts);
+  const char *start = begin;
+  for (size_t i = 1; i < parts && start < end; i++) {
+    const char *cut = begin + i * step;
+    if (cut <= start)
+      continue;
+    const char *eol = (const char *)memchr(cut, '\n', end - cut);
+    if (!eol)
+      break;
+    chunks.emplace_back(start, eol + 1 - start);
+    start = eol + 1;
+  }
+  if (start < end)
+    chunks.emplace_back(start, end - start);
+  return chunks;
+}
+
+/*! Devuelve la siguiente línea de un fragmento, sin el salto de línea.
+  \param chunk fragmento restante (se consume la línea devuelta).
+  \param line línea leída.
+  \return false si el fragmento se ha consumido por completo.
+*/
+bool nextLine(string_view &chunk, string_view &line) {
+  if (chunk.empty())
+    return false;
+  const size_t eol = chunk.find('\n');
+  if (eol == string_view::npos) {
+    line = chunk;
+    chunk = string_view();
+  } else {
+    line = chunk.substr(0, eol);
+    chunk.remove_prefix(eol + 1);
+  }
+  return true;
+}
+
+/*! Tabla parcial obtenida por un hilo. Los diccionarios son locales al
+    fragmento leído y sus valores son vistas sobre el fichero proyectado.
+*/
+struct ChunkTable {
+  vector<vector<string_view>> dictionaries;
+  vector<vector<uint32_t>> codes;
+  size_t rows = 0;
+};
+
+/*! Codifica por columnas las líneas de un fragmento del fichero.
+  \param chunk fragmento del fichero.
+  \param delimiter delimitador de celdas.
+  \param ncols número de atributos de la cabecera.
+  \param result tabla parcial del fragmento.
+*/
+void parseChunk(string_view chunk, const char delimiter, const size_t ncols,
+                ChunkTable &result) {
+  vector<unordered_map<string_view, uint32_t>> indexes(ncols);
+  result.dictionaries.resize(ncols);
+  result.codes.resize(ncols);
+
+  string_view line;
+  vector<string_view> cells;
+  while (nextLine(chunk, line)) {
+    // No leer líneas vacías
+    if (line.empty())
+      continue;
+
+    splitLine(line, delimiter, cells);
+
+    // Registro con más atributos que la cabecera
+    while (result.codes.size() < cells.size()) {
+      indexes.emplace_back();
+      result.dictionaries.emplace_back();
+      result.codes.emplace_back(result.rows, 0);
+      if (result.rows > 0) {
+        indexes.back().emplace(string_view(), 0);
+        result.dictionaries.back().emplace_back();
+      }
+    }
+
+    for (size_t j = 0; j < result.codes.size(); j++) {
+      // Los registros incompletos se completan con valores vacíos
+      const string_view cell = j < cells.size() ? cells[j] : string_view();
+      auto it = indexes[j].find(cell);
+      if (it == indexes[j].end()) {
+        it = indexes[j].emplace(cell, result.dictionaries[j].size()).first;
+        result.dictionaries[j].emplace_back(cell);
+      }
+      result.codes[j].emplace_back(it->second);
+    }
+    result.rows++;
+  }
+}
+
+/*! Une las columnas de las tablas parciales en el orden del fichero,
+    traduciendo los códigos locales de cada fragmento al diccionario global.
+  \param chunks tablas parciales.
+  \param col índice del atributo.
+  \param rows número total de registros.
+  \return columna codificada.
+*/
+Column mergeColumn(const vector<ChunkTable> &chunks, const size_t col,
+                   const size_t rows) {
+  unordered_map<string_view, uint32_t> index;
+  vector<string> dictionary;
+  vector<uint32_t> codes;
+  codes.reserve(rows);
+
+  auto encode = [&index, &dictionary](const string_view value) {
+    auto it = index.find(value);
+    if (it == index.end()) {
+      it = index.emplace(value, dictionary.size()).first;
+      dictionary.emplace_back(value);
+    }
+    return it->second;
+  };
+
+  vector<uint32_t> mapping;
+  for (const ChunkTable &chunk : chunks) {
+    // Atributo ausente en el fragmento: celdas vacías
+    if (col >= chunk.codes.size()) {
+      if (chunk.rows > 0)
+        codes.insert(codes.end(), chunk.rows, encode(string_view()));
+      continue;
+    }
+
+    mapping.clear();
+    for (const string_view &value : chunk.dictionaries[col])
+      mapping.emplace_back(encode(value));
+    for (const uint32_t code : chunk.codes[col])
+      codes.emplace_back(mapping[code]);
+  }
+
+  return Column(move(dictionary), move(codes));
+}
+
+/*! Lee un fichero csv y lo codifica por columnas. El fichero se divide en
+    fragmentos alineados a línea que se procesan en paralelo, cada uno con
+    sus propios diccionarios, y que se unen finalmente en el orden del
+    fichero. Las celdas se comparan como vistas sobre el fichero proyectado,
+    de modo que únicamente se reserva memoria para cada valor distinto de
+    cada columna.
+  \param filename ruta del fichero csv.
+  \param headers cabecera del fichero (primera línea).
+  \param delimiter delimitador de celdas.
+  \return tabla codificada.
+*/
+Table readCsvTable(const string &filename, vector<string> &headers,
+                   const char delimiter) {
+  MappedFile file(filename);
+  string_view content(file.begin(), file.size());
+
+  // Cabecera
+  string_view line;
+  vector<string_view> cells;
+  if (nextLine(content, line)) {
+    splitLine(line, delimiter, cells);
+    for (const string_view &cell : cells)
+      headers.emplace_back(cell);
+  }
+
+  // Lectura en paralelo de cada fragmento
+  const vector<string_view> ranges =
+      splitChunks(content.data(), content.data() + content.size(),
+                  parseThreads(content.size()));
+  vector<ChunkTable> chunks(ranges.size());
+  vector<thread> workers;
+  for (size_t i = 1; i < ranges.size(); i++)
+    workers.emplace_back(parseChunk, ranges[i], delimiter, headers.size(),
+                         ref(chunks[i]));
+  if (!ranges.empty())
+    parseChunk(ranges[0], delimiter, headers.size(), chunks[0]);
+  for (thread &worker : workers)
+    worker.join();
+
+  size_t rows = 0, ncols = headers.size();
+  for (const ChunkTable &chunk : chunks) {
+    rows += chunk.rows;
+    ncols = max(ncols, chunk.codes.size());
+  }
+
+  // Unión de las columnas, repartidas entre los hilos
+  vector<Column> columns(ncols);
+  const size_t nworkers = min(ncols, max((size_t)1, chunks.size()));
+  auto mergeColumns = [&](const size_t first) {
+    for (size_t j = first; j < ncols; j += nworkers)
+      columns[j] = mergeColumn(chunks, j, rows);
+  };
+  workers.clear();
+  for (size_t i = 1; i < nworkers; i++)
+    workers.emplace_back(mergeColumns, i);
+  if (nworkers > 0)
+    mergeColumns(0);
+  for (thread &worker : workers)
+    worker.join();
+
+  return Table(headers, move(columns));
+}
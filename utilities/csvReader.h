@@ -0,0 +1,43 @@
+/*! \file csvReader.h
+    \brief Fichero de cabecera del archivo csvReader.cpp.
+*/
+
+#ifndef _CSVREADER_H
+#define _CSVREADER_H
+
+#include "table.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+/*! Clase MappedFile. Proyecta un fichero completo en memoria (mmap) en modo
+    de solo lectura, liberándolo al destruirse.
+*/
+class MappedFile {
+private:
+  const char *data = nullptr;
+  size_t length = 0;
+
+public:
+  MappedFile(const string &filename);
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile();
+  const char *begin() const;
+  const char *end() const;
+  size_t size() const;
+};
+
+size_t parseThreads(const size_t bytes);
+vector<string_view> splitChunks(const char *begin, const char *end,
+                                const size_t parts);
+bool nextLine(string_view &chunk, string_view &line);
+void splitLine(string_view line, const char delimiter,
+               vector<string_view> &cells);
+Table readCsvTable(const string &filename, vector<string> &headers,
+                   const char delimiter = ';');
+
+#endif
@@ -0,0 +1,312 @@
+/*! \file datasetCache.cpp
+    \brief Fichero que contiene la caché binaria de los conjuntos de datos.
+           Almacena las columnas codificadas, sus diccionarios y las
+           jerarquías ya convertidas en listas de códigos, de modo que las
+           siguientes ejecuciones sobre el mismo directorio no tengan que
+           volver a procesar los ficheros csv.
+*/
+
+#include "datasetCache.h"
+#include "csvReader.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+#include <unordered_map>
+
+// Identificador y versión del formato de la caché
+static const char cacheMagic[8] = {'S', 'D', 'P', 'C', 'A', 'C', 'H', 'E'};
+static const uint32_t cacheVersion = 1;
+
+/*! Clase CacheWriter. Escribe valores binarios en un fichero de caché.
+*/
+class CacheWriter {
+private:
+  ofstream &output;
+
+public:
+  CacheWriter(ofstream &output) : output(output) {}
+
+  template <typename T> void write(const T value) {
+    this->output.write((const char *)&value, sizeof(T));
+  }
+
+  void writeString(const string &value) {
+    write<uint32_t>(value.size());
+    this->output.write(value.data(), value.size());
+  }
+
+  void writeCodes(const vector<uint32_t> &codes) {
+    this->output.write((const char *)codes.data(),
+                       codes.size() * sizeof(uint32_t));
+  }
+};
+
+/*! Clase CacheReader. Lee valores binarios de un fichero de caché proyectado
+    en memoria, comprobando que no se sobrepasa su final.
+*/
+class CacheReader {
+private:
+  const char *ptr;
+  const char *end;
+
+  void require(const size_t bytes) {
+    if ((size_t)(this->end - this->ptr) < bytes)
+      throw "Error, truncated cache file.";
+  }
+
+public:
+  CacheReader(const MappedFile &file) : ptr(file.begin()), end(file.end()) {}
+
+  template <typename T> T read() {
+    T value;
+    require(sizeof(T));
+    memcpy(&value, this->ptr, sizeof(T));
+    this->ptr += sizeof(T);
+    return value;
+  }
+
+  string readString() {
+    const uint32_t length = read<uint32_t>();
+    require(length);
+    string value(this->ptr, length);
+    this->ptr += length;
+    return value;
+  }
+
+  vector<uint32_t> readCodes(const size_t count) {
+    require(count * sizeof(uint32_t));
+    vector<uint32_t> codes(count);
+    memcpy(codes.data(), this->ptr, count * sizeof(uint32_t));
+    this->ptr += count * sizeof(uint32_t);
+    return codes;
+  }
+};
+
+/*! Calcula la versión de los ficheros de entrada de un directorio.
+  \param csvFile ruta del conjunto de datos.
+  \param hierarchyFiles rutas de los ficheros de jerarquía.
+  \return tamaño y fecha de modificación de cada fichero, ordenados por
+          nombre.
+*/
+vector<SourceStamp> stampSources(const string &csvFile,
+                                 const vector<string> &hierarchyFiles) {
+  vector<SourceStamp> sources;
+  auto stamp = [&sources](const fs::path &path) {
+    sources.push_back(
+        {path.filename(), fs::file_size(path),
+         (int64_t)fs::last_write_time(path).time_since_epoch().count()});
+  };
+
+  stamp(csvFile);
+  for (const string &file : hierarchyFiles)
+    stamp(file);
+
+  sort(sources.begin() + 1, sources.end(),
+       [](const SourceStamp &a, const SourceStamp &b) {
+         return a.name < b.name;
+       });
+  return sources;
+}
+
+/*! Devuelve la ruta de la caché de un conjunto de datos.
+  \param directory directorio del conjunto de datos.
+  \param csvName nombre del fichero csv.
+  \return ruta del fichero de caché.
+*/
+fs::path cachePath(fs::path const &directory, const string &csvName) {
+  return directory / ".cache" / (fs::path(csvName).stem().string() + ".bin");
+}
+
+/*! Carga un conjunto de datos desde su caché binaria.
+  \param cacheFile ruta del fichero de caché.
+  \param sources versión actual de los ficheros de entrada.
+  \param headers cabecera del fichero.
+  \param table conjunto de datos codificado por columnas.
+  \param hierarchies contenido de los ficheros de jerarquía.
+  \return false si la caché no existe, está dañada o no corresponde a los
+          ficheros de entrada actuales.
+*/
+bool loadDatasetCache(const fs::path &cacheFile,
+                      const vector<SourceStamp> &sources,
+                      vector<string> &headers, Table &table,
+                      vector<HierarchyData> &hierarchies) {
+  if (!fs::exists(cacheFile))
+    return false;
+
+  try {
+    MappedFile file(cacheFile);
+    CacheReader reader(file);
+
+    char magic[sizeof(cacheMagic)];
+    for (char &c : magic)
+      c = reader.read<char>();
+    if (memcmp(magic, cacheMagic, sizeof(cacheMagic)) != 0 ||
+        reader.read<uint32_t>() != cacheVersion)
+      return false;
+
+    // Invalidar la caché si alguno de los ficheros ha cambiado
+    if (reader.read<uint32_t>() != sources.size())
+      return false;
+    for (const SourceStamp &source : sources) {
+      if (reader.readString() != source.name ||
+          reader.read<uint64_t>() != source.size ||
+          reader.read<int64_t>() != source.mtime)
+        return false;
+    }
+
+    // Cabecera
+    vector<string> cachedHeaders(reader.read<uint32_t>());
+    for (string &header : cachedHeaders)
+      header = reader.readString();
+
+    // Columnas codificadas
+    const uint32_t ncols = reader.read<uint32_t>();
+    const uint64_t rows = reader.read<uint64_t>();
+    vector<Column> columns;
+    for (uint32_t j = 0; j < ncols; j++) {
+      vector<string> dictionary(reader.read<uint32_t>());
+      for (string &value : dictionary)
+        value = reader.readString();
+      vector<uint32_t> codes = reader.readCodes(rows);
+      for (const uint32_t code : codes) {
+        if (code >= dictionary.size())
+          return false;
+      }
+      columns.emplace_back(move(dictionary), move(codes));
+    }
+
+    // Jerarquías como listas de códigos por fila
+    vector<HierarchyData> cachedHierarchies(reader.read<uint32_t>());
+    for (HierarchyData &hierarchy : cachedHierarchies) {
+      hierarchy.file = reader.readString();
+      hierarchy.name = reader.readString();
+
+      vector<string> dictionary(reader.read<uint32_t>());
+      for (string &value : dictionary)
+        value = reader.readString();
+
+      vector<uint32_t> lengths = reader.readCodes(reader.read<uint32_t>());
+      size_t total = 0;
+      for (const uint32_t length : lengths)
+        total += length;
+      const vector<uint32_t> codes = reader.readCodes(total);
+
+      size_t pos = 0;
+      hierarchy.rows.reserve(lengths.size());
+      for (const uint32_t length : lengths) {
+        vector<string> row;
+        row.reserve(length);
+        for (uint32_t k = 0; k < length; k++, pos++) {
+          if (codes[pos] >= dictionary.size())
+            return false;
+          row.emplace_back(dictionary[codes[pos]]);
+        }
+        hierarchy.rows.emplace_back(move(row));
+      }
+    }
+
+    headers.insert(headers.end(), cachedHeaders.begin(), cachedHeaders.end());
+    table = Table(move(cachedHeaders), move(columns));
+    hierarchies = move(cachedHierarchies);
+  } catch (...) {
+    return false;
+  }
+
+  return true;
+}
+
+/*! Guarda un conjunto de datos en su caché binaria. El fichero se escribe
+    primero de forma temporal y se renombra al terminar, de modo que otra
+    ejecución nunca lea una caché incompleta.
+  \param cacheFile ruta del fichero de caché.
+  \param sources versión de los ficheros de entrada.
+  \param headers cabecera del fichero.
+  \param table conjunto de datos codificado por columnas.
+  \param hierarchies contenido de los ficheros de jerarquía.
+  \return true si la caché se escribió correctamente.
+*/
+bool saveDatasetCache(const fs::path &cacheFile,
+                      const vector<SourceStamp> &sources,
+                      const vector<string> &headers, const Table &table,
+                      const vector<HierarchyData> &hierarchies) {
+  const fs::path tmpFile =
+      cacheFile.string() + ".tmp" + to_string(getpid());
+
+  try {
+    fs::create_directories(cacheFile.parent_path());
+
+    ofstream output(tmpFile, ios::binary | ios::trunc);
+    if (!output.is_open())
+      return false;
+    CacheWriter writer(output);
+
+    for (const char c : cacheMagic)
+      writer.write<char>(c);
+    writer.write<uint32_t>(cacheVersion);
+
+    writer.write<uint32_t>(sources.size());
+    for (const SourceStamp &source : sources) {
+      writer.writeString(source.name);
+      writer.write<uint64_t>(source.size);
+      writer.write<int64_t>(source.mtime);
+    }
+
+    writer.write<uint32_t>(headers.size());
+    for (const string &header : headers)
+      writer.writeString(header);
+
+    writer.write<uint32_t>(table.numColumns());
+    writer.write<uint64_t>(table.numRows());
+    for (size_t j = 0; j < table.numColumns(); j++) {
+      const Column &column = table.getColumn(j);
+      writer.write<uint32_t>(column.cardinality());
+      for (const string &value : column.getDictionary())
+        writer.writeString(value);
+      writer.writeCodes(column.getCodes());
+    }
+
+    writer.write<uint32_t>(hierarchies.size());
+    for (const HierarchyData &hierarchy : hierarchies) {
+      writer.writeString(hierarchy.file);
+      writer.writeString(hierarchy.name);
+
+      // Codificar los valores de la jerarquía
+      unordered_map<string, uint32_t> index;
+      vector<string> dictionary;
+      vector<uint32_t> lengths, codes;
+      for (const vector<string> &row : hierarchy.rows) {
+        lengths.emplace_back(row.size());
+        for (const string &value : row) {
+          auto it = index.find(value);
+          if (it == index.end()) {
+            it = index.emplace(value, dictionary.size()).first;
+            dictionary.emplace_back(value);
+          }
+          codes.emplace_back(it->second);
+        }
+      }
+
+      writer.write<uint32_t>(dictionary.size());
+      for (const string &value : dictionary)
+        writer.writeString(value);
+      writer.write<uint32_t>(lengths.size());
+      writer.writeCodes(lengths);
+      writer.writeCodes(codes);
+    }
+
+    output.close();
+    if (!output) {
+      fs::remove(tmpFile);
+      return false;
+    }
+    fs::rename(tmpFile, cacheFile);
+  } catch (...) {
+    // Directorio sin permisos de escritura: se continúa sin caché
+    error_code ec;
+    fs::remove(tmpFile, ec);
+    return false;
+  }
+
+  return true;
+}
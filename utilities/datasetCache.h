@@ -0,0 +1,47 @@
+/*! \file datasetCache.h
+    \brief Fichero de cabecera del archivo datasetCache.cpp.
+*/
+
+#ifndef _DATASETCACHE_H
+#define _DATASETCACHE_H
+
+#include "table.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+/*! Estructura HierarchyData. Contenido de un fichero de jerarquía: nombre del
+    atributo (primera línea) y cada una de sus filas de generalización.
+*/
+struct HierarchyData {
+  string file;
+  string name;
+  vector<vector<string>> rows;
+};
+
+/*! Estructura SourceStamp. Identifica la versión de un fichero de entrada
+    por su tamaño y su fecha de modificación.
+*/
+struct SourceStamp {
+  string name;
+  uint64_t size;
+  int64_t mtime;
+};
+
+vector<SourceStamp> stampSources(const string &csvFile,
+                                 const vector<string> &hierarchyFiles);
+fs::path cachePath(fs::path const &directory, const string &csvName);
+bool loadDatasetCache(const fs::path &cacheFile,
+                      const vector<SourceStamp> &sources,
+                      vector<string> &headers, Table &table,
+                      vector<HierarchyData> &hierarchies);
+bool saveDatasetCache(const fs::path &cacheFile,
+                      const vector<SourceStamp> &sources,
+                      const vector<string> &headers, const Table &table,
+                      const vector<HierarchyData> &hierarchies);
+
+#endif
@@ -5,115 +5,38 @@
 
 #include "frequencies.h"
 
-/*! Calcula la frecuencia de un conjunto de qids en el conjunto de datos.
-  \param dataset conjunto de datos.
+/*! Agrupa los registros de una tabla codificada por su conjunto de qids.
+  \param table conjunto de datos codificado.
   \param qids índices de los atributos qids.
-  \return frecuencias representadas en forma de contenedor asociativo entre una
-          cadena de caracteres y una tupla, conteniendo esta última la frecuencia y
-          el conjunto de qids al que hace referencia.
-*/
-map<string, tuple<int, vector<int>>>
-evaluateFrequencyByIdx(vector<vector<string>> dataset, vector<int> qids) {
-  map<string, tuple<int, vector<int>>> idxs;
-
-  // Concatenate all elements
-  for (size_t i = 0; i < dataset.size(); i++) {
-    vector<string> record;
-    for (const auto &qid : qids) {
-      record.emplace_back(dataset[i][qid]);
-    }
-
-    string s;
-    for (auto const &value : record) {
-      s += value;
-    }
-
-    // Save indexes
-    try {
-      get<0>(idxs[s]) = get<0>(idxs[s]) + 1;
-      get<1>(idxs[s]).emplace_back(i);
-    } catch (...) {
-      idxs[s] = make_tuple(1, vector<int>(i));
-    }
-  }
-
-  return idxs;
-}
-
-/*! Concatena todos los valores presentes en cada registro presentes en
-    una matriz de dimensión 2.
-  \param dataset conjunto de datos.
-  \return vector que contiene todas las concatenaciones de valores.
+  \return agrupación de los registros, conteniendo la frecuencia y los índices
+          de los registros de cada combinación de qids.
 */
-vector<string> concatRecords(vector<vector<string>> dataset) {
-  vector<string> records;
-
-  // Concatenate all elements
-  for (size_t i = 0; i < dataset.size(); i++) {
-    string s;
-    for (auto const &value : dataset[i])
-      s += value;
-    records.emplace_back(s);
-  }
-
-  return records;
+Grouping evaluateFrequencyByIdx(const Table &table, const vector<int> &qids) {
+  return Grouping(table, qids, true);
 }
 
-/*! Calcula la frecuencia de un  qid en el conjunto de datos.
+/*! Calcula la frecuencia de cada combinación de valores en el conjunto de
+    datos.
   \param dataset conjunto de datos.
-  \param qids índices de los atributos qids.
-  \return frecuencias representadas en forma de contenedor asociativo entre una
-          cadena de caracteres (como una concatenación de todos los atributos)
-          y la frecuencia de dicho conjunto de qids en el conjunto de datos.
+  \return frecuencias del conjunto de qids en el conjunto de datos.
 */
-map<string, int> calculateQidFreqs(const vector<vector<string>> dataset,
-                                   const int dim) {
-
-  vector<vector<string>> records = dataset;
-
-  // Calculate frequency list
-  map<string, int> freqs;
+vector<int> calculateFreqs(const vector<vector<string>> &dataset) {
+  if (dataset.empty())
+    return {};
 
-  for (const auto &record : records) {
-    try {
-      freqs[record[dim]] += 1;
-    } catch (...) {
-      freqs[record[dim]] = 1;
-    }
-  }
-
-  return freqs;
+  vector<int> qids(dataset[0].size());
+  iota(qids.begin(), qids.end(), 0);
+  return Grouping(dataset, qids).getCounts();
 }
 
-/*! Calcula la frecuencia de un conjunto de qids en el conjunto de datos.
-  \param dataset conjunto de datos.
+/*! Calcula la frecuencia de cada combinación de códigos de los qids en una
+    tabla codificada.
+  \param table conjunto de datos codificado.
   \param qids índices de los atributos qids.
   \return frecuencias del conjunto de qids en el conjunto de datos.
 */
-vector<int> calculateFreqs(const vector<vector<string>> dataset) {
-
-  // Concatenate all attributes of each record
-  vector<string> records = concatRecords(dataset);
-
-  // Calculate frequency list
-  map<string, int> freqMap;
-  for (const auto &record : records) {
-    try {
-      freqMap[record] += 1;
-    } catch (...) {
-      cout << freqMap[record] << endl;
-      freqMap[record] = 1;
-    }
-  }
-
-  // Get all values from freqMap
-  vector<int> freqs;
-  for (map<string, int>::iterator it = freqMap.begin(); it != freqMap.end();
-       it++) {
-    freqs.push_back(it->second);
-  }
-
-  return freqs;
+vector<int> calculateFreqs(const Table &table, const vector<int> &qids) {
+  return Grouping(table, qids).getCounts();
 }
 
 /*! Devuelve el qid que mayor número de valores únicos presenta en el
@@ -150,63 +73,58 @@ int findMostDistinctQid(const vector<vector<string>> dataset) {
   return distance(nvalues.begin(), max_element(nvalues.begin(), nvalues.end()));
 }
 
-/*! Genera las clases de equivalencia a partir de un conjunto de datos,
-    en el que cada uno de sus registro presentan el mismo conjunto de qids.
-  \param dataset conjunto de datos.
+/*! Devuelve el qid que mayor número de valores únicos presenta en una
+    tabla codificada.
+  \param table conjunto de datos codificado.
   \param qids índices de los atributos qids.
-  \return clases de equivalencia en forma de una matriz de dimensión 3.
+  \return posición del qid resultante dentro de la lista de qids.
 */
-vector<vector<vector<string>>> createClusters(vector<vector<string>> dataset,
-                                              vector<int> qids) {
-  // Construct clusters based on generalizations
-  vector<vector<vector<string>>> clusters;
-  // Map every unique combination of qids to a matrix/cluster;
-  map<string, vector<vector<string>>> splitMap;
-
-  for (const auto &entry : dataset) {
-    string value;
-    vector<string> record = entry;
-    for (const auto &qid : qids)
-      value.append(entry[qid]);
-
-    try {
-      splitMap[value].emplace_back(record);
-    } catch (...) {
-      splitMap[value] = vector<vector<string>>(1, record);
+int findMostDistinctQid(const Table &table, const vector<int> &qids) {
+  vector<int> nvalues;
+
+  for (const int &qid : qids) {
+    const Column &column = table.getColumn(qid);
+    // El diccionario puede contener valores que ya no se encuentran presentes
+    vector<bool> seen(column.cardinality(), false);
+    int count = 0;
+    for (const uint32_t &code : column.getCodes()) {
+      if (!seen[code]) {
+        seen[code] = true;
+        count++;
+      }
     }
+    nvalues.emplace_back(count);
   }
 
-  // Create clusters from map values
-  for (const auto &[k, v] : splitMap)
-    clusters.emplace_back(v);
-
-  return clusters;
+  return distance(nvalues.begin(), max_element(nvalues.begin(), nvalues.end()));
 }
 
-/*! Crea una tupla conteninendo las frecuencias de cada atributo sensible y
-    una lista de los valores únicos de cada atributo sensible.
+/*! Genera las clases de equivalencia a partir de un conjunto de datos,
+    en el que cada uno de sus registro presentan el mismo conjunto de qids.
   \param dataset conjunto de datos.
-  \param confAtts índices de los atributos sensibles o SAs.
-  \return tupla resultante.
+  \param qids índices de los atributos qids.
+  \return clases de equivalencia en forma de una matriz de dimensión 3.
 */
-tuple<vector<map<string, int>>, vector<set<string>>>
-createDataMap(vector<vector<string>> dataset, vector<int> confAtts) {
-
-  vector<map<string, int>> dataMaps(confAtts.size());
-  vector<set<string>> valueSets(confAtts.size());
-  string key;
-
-  for (const auto &entry : dataset) {
-    for (size_t j = 0; j < confAtts.size(); j++) {
-      key = entry[confAtts[j]];
-      try {
-        dataMaps[j][key] += 1;
-      } catch (...) {
-        dataMaps[j][key] = 1;
-      }
-      valueSets[j].insert(key);
-    }
+vector<vector<vector<string>>>
+createClusters(const vector<vector<string>> &dataset, const vector<int> &qids) {
+  // Map every unique combination of qids to a packed integer key
+  vector<vector<uint32_t>> codes(qids.size());
+  vector<const uint32_t *> columns;
+  vector<uint32_t> radices;
+  for (size_t j = 0; j < qids.size(); j++) {
+    radices.emplace_back(encodeColumn(dataset, qids[j], codes[j]));
+    columns.emplace_back(codes[j].data());
   }
+  const vector<vector<int>> classes =
+      QidKeyEncoder(radices).equivalenceClasses(columns, dataset.size());
 
-  return make_tuple(dataMaps, valueSets);
-};
+  // Construct clusters based on generalizations
+  vector<vector<vector<string>>> clusters(classes.size());
+  for (size_t c = 0; c < classes.size(); c++) {
+    clusters[c].reserve(classes[c].size());
+    for (const int &i : classes[c])
+      clusters[c].emplace_back(dataset[i]);
+  }
+
+  return clusters;
+}
@@ -5,24 +5,25 @@
 #ifndef _FREQUENCIES_H
 #define _FREQUENCIES_H
 
+#include "grouping.h"
+#include "qidKey.h"
+#include "table.h"
 #include <algorithm>
 #include <iostream>
 #include <map>
 #include <numeric>
 #include <tuple>
 #include <set>
+#include <vector>
 
 using namespace std;
 
-map<string, tuple<int, vector<int>>>
-evaluateFrequencyByIdx(vector<vector<string>> dataset, vector<int> qids);
-vector<int> calculateFreqs(vector<vector<string>> dataset);
+Grouping evaluateFrequencyByIdx(const Table &table, const vector<int> &qids);
+vector<int> calculateFreqs(const vector<vector<string>> &dataset);
+vector<int> calculateFreqs(const Table &table, const vector<int> &qids);
 int findMostDistinctQid(const vector<vector<string>> dataset);
-map<string, int> calculateQidFreqs(const vector<vector<string>> dataset,
-                                   const int dim);
-vector<vector<vector<string>>> createClusters(vector<vector<string>> dataset,
-                                              vector<int> qids);
-tuple<vector<map<string, int>>, vector<set<string>>>
-createDataMap(vector<vector<string>> dataset, vector<int> confAtts);
+int findMostDistinctQid(const Table &table, const vector<int> &qids);
+vector<vector<vector<string>>>
+createClusters(const vector<vector<string>> &dataset, const vector<int> &qids);
 
 #endif
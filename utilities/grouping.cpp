@@ -0,0 +1,169 @@
+/*! \file grouping.cpp
+    \brief Fichero que contiene la clase Grouping, responsable de agrupar los
+           registros de un conjunto de datos por su combinación de qids.
+*/
+
+#include "grouping.h"
+#include <climits>
+
+/*! Calcula el hash de la tupla de códigos de un registro.
+  \param columns códigos de cada uno de los qids.
+  \param row índice del registro.
+  \return valor hash.
+*/
+static inline uint64_t hashRow(const vector<const uint32_t *> &columns,
+                               const size_t row) {
+  uint64_t h = 0x9E3779B97F4A7C15ULL;
+  for (const uint32_t *column : columns) {
+    h ^= column[row];
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 31;
+  }
+  // Finalizador de splitmix64
+  h ^= h >> 30;
+  h *= 0x94D049BB133111EBULL;
+  h ^= h >> 27;
+  return h;
+}
+
+/*! Comprueba si dos registros presentan la misma tupla de códigos.
+  \param columns códigos de cada uno de los qids.
+  \param r1 índice del primer registro.
+  \param r2 índice del segundo registro.
+  \return true si ambos registros pertenecen al mismo grupo.
+*/
+static inline bool sameRow(const vector<const uint32_t *> &columns,
+                           const size_t r1, const size_t r2) {
+  for (const uint32_t *column : columns) {
+    if (column[r1] != column[r2])
+      return false;
+  }
+  return true;
+}
+
+//! Constructor vacio
+Grouping::Grouping(){};
+
+/*! Constructor. Agrupa los registros de una tabla codificada.
+  \param table conjunto de datos codificado.
+  \param qids índices de los atributos qids.
+  \param withRows indica si se deben guardar los registros de cada grupo.
+*/
+Grouping::Grouping(const Table &table, const vector<int> &qids,
+                   const bool withRows) {
+  vector<const uint32_t *> columns;
+  for (const int &qid : qids)
+    columns.emplace_back(table.getColumn(qid).getCodes().data());
+
+  build(columns, table.numRows(), withRows);
+}
+
+/*! Constructor. Agrupa los registros de un conjunto de datos representado
+    por filas, codificando previamente los valores de cada qid.
+  \param dataset conjunto de datos.
+  \param qids índices de los atributos qids.
+  \param withRows indica si se deben guardar los registros de cada grupo.
+*/
+Grouping::Grouping(const vector<vector<string>> &dataset,
+                   const vector<int> &qids, const bool withRows) {
+  vector<vector<uint32_t>> codes(qids.size());
+  vector<const uint32_t *> columns;
+
+  for (size_t j = 0; j < qids.size(); j++) {
+    encodeColumn(dataset, qids[j], codes[j]);
+    columns.emplace_back(codes[j].data());
+  }
+
+  build(columns, dataset.size(), withRows);
+}
+
+/*! Agrupa los registros a partir de los códigos de sus qids.
+  \param columns códigos de cada uno de los qids.
+  \param numRows número de registros.
+  \param withRows indica si se deben guardar los registros de cada grupo.
+*/
+void Grouping::build(const vector<const uint32_t *> &columns,
+                     const size_t numRows, const bool withRows) {
+  this->groupIds.resize(numRows);
+
+  // Tabla hash de direccionamiento abierto (sondeo lineal). Cada posición
+  // guarda el identificador del grupo, o -1 si se encuentra vacía
+  size_t capacity = 16;
+  vector<int> slots(capacity, -1);
+  vector<uint64_t> hashes;
+
+  for (size_t i = 0; i < numRows; i++) {
+    const uint64_t h = hashRow(columns, i);
+    size_t pos = h & (capacity - 1);
+
+    while (slots[pos] != -1) {
+      const int group = slots[pos];
+      if (hashes[group] == h && sameRow(columns, this->firstRows[group], i))
+        break;
+      pos = (pos + 1) & (capacity - 1);
+    }
+
+    int group = slots[pos];
+    if (group == -1) {
+      group = this->counts.size();
+      slots[pos] = group;
+      hashes.emplace_back(h);
+      this->counts.emplace_back(0);
+      this->firstRows.emplace_back(i);
+      if (withRows)
+        this->rows.emplace_back();
+
+      // Mantener un factor de carga menor a 1/2
+      if (this->counts.size() * 2 > capacity) {
+        capacity *= 2;
+        slots.assign(capacity, -1);
+        for (size_t g = 0; g < hashes.size(); g++) {
+          size_t p = hashes[g] & (capacity - 1);
+          while (slots[p] != -1)
+            p = (p + 1) & (capacity - 1);
+          slots[p] = g;
+        }
+      }
+    }
+
+    this->groupIds[i] = group;
+    this->counts[group]++;
+    if (withRows)
+      this->rows[group].emplace_back(i);
+  }
+}
+
+/*! Devuelve el número de grupos.
+  \return número de combinaciones distintas de qids.
+*/
+size_t Grouping::numGroups() const { return this->counts.size(); }
+
+/*! Devuelve el grupo de cada registro.
+  \return identificador del grupo de cada registro.
+*/
+const vector<uint32_t> &Grouping::getGroupIds() const {
+  return this->groupIds;
+}
+
+/*! Devuelve el tamaño de cada grupo.
+  \return frecuencia de cada combinación de qids.
+*/
+const vector<int> &Grouping::getCounts() const { return this->counts; }
+
+/*! Devuelve los registros de cada grupo. Únicamente disponible si se
+    solicitó al construir la agrupación.
+  \return índices de los registros de cada grupo.
+*/
+const vector<vector<int>> &Grouping::getRows() const { return this->rows; }
+
+/*! Devuelve el tamaño del menor de los grupos.
+  \return frecuencia mínima, o INT_MAX si no hay registros.
+*/
+int Grouping::minCount() const {
+  int min = INT_MAX;
+  for (const int &count : this->counts) {
+    if (count < min)
+      min = count;
+  }
+  return min;
+}
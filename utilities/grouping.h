@@ -0,0 +1,45 @@
+/*! \file grouping.h
+    \brief Fichero de cabecera del archivo grouping.cpp.
+*/
+
+#ifndef _GROUPING_H
+#define _GROUPING_H
+
+#include "qidKey.h"
+#include "table.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*! Clase Grouping. Agrupa los registros de un conjunto de datos según la
+    combinación de valores de sus qids. Cada combinación se representa como
+    una tupla de códigos de ancho fijo y se busca en una tabla hash de
+    direccionamiento abierto, comparando los códigos en lugar de cadenas de
+    caracteres concatenadas. Los grupos se numeran en orden de aparición.
+*/
+class Grouping {
+private:
+  vector<uint32_t> groupIds;
+  vector<int> counts;
+  vector<size_t> firstRows;
+  vector<vector<int>> rows;
+
+  void build(const vector<const uint32_t *> &columns, const size_t numRows,
+             const bool withRows);
+
+public:
+  Grouping();
+  Grouping(const Table &table, const vector<int> &qids,
+           const bool withRows = false);
+  Grouping(const vector<vector<string>> &dataset, const vector<int> &qids,
+           const bool withRows = false);
+  size_t numGroups() const;
+  const vector<uint32_t> &getGroupIds() const;
+  const vector<int> &getCounts() const;
+  const vector<vector<int>> &getRows() const;
+  int minCount() const;
+};
+
+#endif
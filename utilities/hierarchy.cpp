@@ -110,10 +110,44 @@ transposeAndFormat(const vector<vector<vector<string>>> &hierarchies) {
   return res;
 }
 
+/*! Lee un fichero de jerarquía.
+  \param filename ruta del fichero.
+  \return nombre del atributo (primera línea) y filas de la jerarquía.
+*/
+HierarchyData readHierarchyFile(const string &filename) {
+  ifstream input{filename};
+  if (!input.is_open()) {
+    throw "Error reading file";
+  }
+
+  HierarchyData hierarchy;
+  hierarchy.file = fs::path(filename).filename();
+
+  // Read first line: qid's hierarchy name
+  getline(input, hierarchy.name);
+
+  // Read hierarchy values
+  string line;
+  for (; getline(input, line);) {
+    // Dont read empty lines
+    if (line.length() == 0)
+      continue;
+    istringstream strm(move(line));
+    vector<string> row;
+    for (string val; getline(strm, val, ';');) {
+      row.emplace_back(val);
+    }
+    hierarchy.rows.emplace_back(row);
+  }
+  input.close();
+
+  return hierarchy;
+}
+
 /*! Lee el directorio general en el que se encuentran los ficheros de jerarquia
     (en un directorio separado) y el conjunto de datos inicial.
   \param directory directorio relativo.
-  \param dataset conjunto de datos.
+  \param table conjunto de datos codificado por columnas.
   \param headers cabecera del fichero. Define los nombres de los atributos presentes.
   \param qids índices de atributos cuasi-identificadores o qids.
   \param atts índices de atributos sensibles o SAs.
@@ -122,7 +156,7 @@ transposeAndFormat(const vector<vector<vector<string>>> &hierarchies) {
   \return índice del atributo
 */
 map<int, vector<vector<string>>>
-readDirectory(fs::path const &directory, vector<vector<string>> &dataset,
+readDirectory(fs::path const &directory, Table &table,
               vector<string> &headers, vector<string> attQids,
               vector<string> confAtts, vector<int> &qids, vector<int> &atts,
               const bool transpose) {
@@ -151,12 +185,17 @@ readDirectory(fs::path const &directory, vector<vector<string>> &dataset,
   }
 
   // Locate csv input file and hierarchies directory
+  // (the directory order is unspecified, so look for the csv file instead
+  // of taking the first entry)
   string file;
   if (fs::exists(directory) && fs::is_directory(directory)) {
-    auto const entry = fs::directory_iterator(directory).operator*();
-    if (fs::is_regular_file(entry) && entry.path().extension() == ".csv")
-      file = entry.path().filename();
-    else
+    for (auto const &entry : fs::directory_iterator(directory)) {
+      if (fs::is_regular_file(entry) && entry.path().extension() == ".csv") {
+        file = entry.path().filename();
+        break;
+      }
+    }
+    if (file.empty())
       throw "Error, file format error.";
   }
   const string filename = string(directory) + "/" + file;
@@ -175,22 +214,28 @@ readDirectory(fs::path const &directory, vector<vector<string>> &dataset,
     throw "Error, directory doesn't exist.";
   }
 
-  // Read csv dataset
-  ifstream input1{filename};
-  if (!input1.is_open()) {
-    throw "Error reading file";
+  // Load the binary snapshot of the directory, or parse the csv dataset
+  // (memory mapped, every column is dictionary encoded) and hierarchy files
+  // and save it for later runs
+  vector<HierarchyData> hierarchiesData;
+  const vector<SourceStamp> sources = stampSources(filename, hierarchies);
+  const fs::path cacheFile = cachePath(directory, file);
+  if (!loadDatasetCache(cacheFile, sources, headers, table,
+                        hierarchiesData)) {
+    table = readCsvTable(filename, headers);
+    for (const string &hierarchyFile : hierarchies)
+      hierarchiesData.emplace_back(readHierarchyFile(hierarchyFile));
+    saveDatasetCache(cacheFile, sources, headers, table, hierarchiesData);
   }
 
-  // Skip headers and insert them into a variable
-  string headers_aux;
-  getline(input1, headers_aux);
+  // Index hierarchies by file name
+  map<string, const HierarchyData *> hierarchiesByFile;
+  for (const HierarchyData &hierarchy : hierarchiesData)
+    hierarchiesByFile[hierarchy.file] = &hierarchy;
 
   // Get a lowercase version of the headers
   vector<string> headersVector;
-  string tmp;
-  stringstream ss(headers_aux);
-  while (getline(ss, tmp, ';')) {
-    headers.push_back(tmp);
+  for (string tmp : headers) {
     transform(tmp.begin(), tmp.end(), tmp.begin(),
               [](unsigned char x) { return tolower(x); });
     headersVector.push_back(tmp);
@@ -205,23 +250,7 @@ readDirectory(fs::path const &directory, vector<vector<string>> &dataset,
       atts.emplace_back(confAttNames.size() - 1);
   }
 
-  // Read input table
-  string line;
-  for (; getline(input1, line);) {
-    // Dont read empty lines
-    if (line.length() == 0)
-      continue;
-
-    istringstream strm(move(line));
-    vector<string> row;
-    for (string val; getline(strm, val, ';');) {
-      row.emplace_back(val);
-    }
-    dataset.emplace_back(row);
-  }
-  input1.close();
-
-  // Read hierarchy files
+  // Select qid and confidential attribute hierarchies
   string qidName;
   vector<string> qidNames;
 
@@ -229,13 +258,13 @@ readDirectory(fs::path const &directory, vector<vector<string>> &dataset,
   vector<vector<vector<string>>> res;
   vector<int> indexes;
   for (const string &filename : hierarchies) {
-    ifstream input2{filename};
-    if (!input2.is_open()) {
+    auto it = hierarchiesByFile.find(fs::path(filename).filename());
+    if (it == hierarchiesByFile.end())
       throw "Error reading file";
-    }
+    const vector<vector<string>> &hierarchy = it->second->rows;
 
-    // Read first line: qid's hierarchy name
-    getline(input2, qidName);
+    // First line: qid's hierarchy name
+    qidName = it->second->name;
     qidNames.emplace_back(qidName);
 
     // Check if it is a qid or a confidential attribute
@@ -247,21 +276,6 @@ readDirectory(fs::path const &directory, vector<vector<string>> &dataset,
         !compareAttQid(qidName, confAttNames))
       continue;
 
-    // Read hierarchy values
-    vector<vector<string>> hierarchy;
-    for (; getline(input2, line);) {
-      // Dont read empty lines
-      if (line.length() == 0)
-        continue;
-      istringstream strm(move(line));
-      vector<string> row;
-      for (string val; getline(strm, val, ';');) {
-        row.emplace_back(val);
-      }
-      hierarchy.emplace_back(row);
-    }
-    input2.close();
-
     // Get hierarchy corresponding qid
     idx = getHierarchyIdx(qidName, headersVector);
     if (!confAttFlag)
@@ -287,6 +301,31 @@ readDirectory(fs::path const &directory, vector<vector<string>> &dataset,
   return hMap;
 }
 
+/*! Lee el directorio general en el que se encuentran los ficheros de jerarquia
+    y el conjunto de datos inicial, devolviendo este último como una matriz
+    de cadenas de caracteres.
+  \param directory directorio relativo.
+  \param dataset conjunto de datos.
+  \param headers cabecera del fichero. Define los nombres de los atributos presentes.
+  \param qids índices de atributos cuasi-identificadores o qids.
+  \param atts índices de atributos sensibles o SAs.
+  \param transpose indica si se desea devolver la matriz de jerarquías de forma
+                   transpuesta.
+  \return mapa de jerarquías de cada atributo.
+*/
+map<int, vector<vector<string>>>
+readDirectory(fs::path const &directory, vector<vector<string>> &dataset,
+              vector<string> &headers, vector<string> attQids,
+              vector<string> confAtts, vector<int> &qids, vector<int> &atts,
+              const bool transpose) {
+  Table table;
+  map<int, vector<vector<string>>> hMap =
+      readDirectory(directory, table, headers, attQids, confAtts, qids, atts,
+                    transpose);
+  dataset = table.decode();
+  return hMap;
+}
+
 /*! Transpone una matriz de dimensión 2.
   \param matrix matriz de dimensión 2.
   \return matriz transpuesta.
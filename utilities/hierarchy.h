@@ -5,6 +5,9 @@
 #ifndef _HIERARCHY_H
 #define _HIERARCHY_H
 
+#include "csvReader.h"
+#include "datasetCache.h"
+#include "table.h"
 #include <algorithm>  // funciones transform y find
 #include <cctype>     // funciones transform y find
 #include <filesystem>
@@ -18,8 +21,14 @@
 using namespace std;
 namespace fs = std::filesystem;
 
+HierarchyData readHierarchyFile(const string &filename);
 string getNumericRoot(const vector<vector<string>> dataset, const int qidIndex);
 map<int, vector<vector<string>>>
+readDirectory(fs::path const &directory, Table &table,
+              vector<string> &headers, vector<string> attQids,
+              vector<string> confAtts, vector<int> &qids, vector<int> &atts,
+              const bool transpose);
+map<int, vector<vector<string>>>
 readDirectory(fs::path const &directory, vector<vector<string>> &dataset,
               vector<string> &headers, vector<string> attQids,
               vector<string> confAtts, vector<int> &qids, vector<int> &atts,
@@ -0,0 +1,505 @@
+/*! \file hierarchyIndex.cpp
+    \brief Fichero que contiene la clase HierarchyIndex, representación
+           compacta e indexada por enteros de un árbol de jerarquía.
+*/
+
+#include "hierarchyIndex.h"
+#include <algorithm>
+#include <climits>
+
+//! Constructor vacio
+HierarchyIndex::HierarchyIndex(){};
+
+/*! Constructor. Los nodos se crean con el mismo criterio que el árbol de
+    jerarquía original (clase Tree): cada fila define el camino desde una
+    hoja hasta la raíz, y el padre y la profundidad de un nodo quedan
+    fijados por la primera fila en la que aparece.
+  \param hierarchy filas de la jerarquía, desde la hoja hasta la raíz.
+*/
+HierarchyIndex::HierarchyIndex(const vector<vector<string>> &hierarchy) {
+  vector<string> parentNames;
+
+  for (const auto &entries : hierarchy) {
+    if (entries.empty())
+      continue;
+
+    // Fila formada por un único valor: hoja y raíz a la vez
+    if (entries.size() == 1) {
+      addLeave(entries[0], entries[0], 0, parentNames);
+      continue;
+    }
+
+    addLeave(entries[0], entries[1], entries.size() - 1, parentNames);
+
+    size_t i;
+    int child = this->ids.at(entries[0]);
+    for (i = 1; i < entries.size() - 1; i++)
+      child = addNode(entries[i], child, &entries[i + 1], parentNames);
+
+    addNode(entries[i], child, NULL, parentNames);
+  }
+
+  buildIndexes(parentNames);
+}
+
+/*! Añade un valor a la jerarquía, sin relaciones.
+  \param value valor del nodo.
+  \return identificador del nodo.
+*/
+int HierarchyIndex::addValue(const string &value) {
+  const int id = this->values.size();
+  this->values.emplace_back(value);
+  this->ids.emplace(value, id);
+  this->parents.emplace_back(id);
+  this->depths.emplace_back(0);
+  this->leafCounts.emplace_back(0);
+  this->leafFlags.emplace_back(false);
+  this->childrenIds.emplace_back();
+  return id;
+}
+
+/*! Añade un nodo hoja a la jerarquía.
+  \param value valor del nodo hoja.
+  \param parent valor del nodo padre.
+  \param depth profundidad en la que se encuentra la hoja.
+  \param parentNames valor del padre de cada nodo, resuelto al finalizar.
+*/
+void HierarchyIndex::addLeave(const string &value, const string &parent,
+                              int depth, vector<string> &parentNames) {
+  // Check if leave is already present
+  if (this->ids.count(value))
+    return;
+
+  const int id = addValue(value);
+  parentNames.emplace_back(parent);
+  this->depths[id] = depth;
+  this->leafFlags[id] = true;
+  this->leafIds.emplace_back(id);
+}
+
+/*! Añade un nodo a la jerarquía.
+  \param value valor del nodo.
+  \param child identificador del nodo hijo.
+  \param parent valor del nodo padre, o NULL si se trata de la raíz.
+  \param parentNames valor del padre de cada nodo, resuelto al finalizar.
+  \return identificador del nodo.
+*/
+int HierarchyIndex::addNode(const string &value, int child,
+                            const string *parent,
+                            vector<string> &parentNames) {
+  // Node already present
+  auto it = this->ids.find(value);
+  if (it != this->ids.end()) {
+    this->childrenIds[it->second].emplace_back(child);
+    this->leafCounts[it->second] += 1;
+    return it->second;
+  }
+
+  // Node not present
+  const int id = addValue(value);
+  if (parent)
+    parentNames.emplace_back(*parent);
+  else {
+    parentNames.emplace_back(value);
+    this->rootId = id;
+  }
+
+  this->depths[id] = this->depths[child] - 1;
+  this->childrenIds[id] = {child};
+  this->leafCounts[id] = 1;
+  return id;
+}
+
+/*! Resuelve los padres de cada nodo y calcula los índices derivados:
+    hijos ordenados, nodos por nivel, profundidad máxima y altura de cada
+    subárbol y tabla de ancestros de cada nodo.
+  \param parentNames valor del padre de cada nodo.
+*/
+void HierarchyIndex::buildIndexes(const vector<string> &parentNames) {
+  for (size_t id = 0; id < parentNames.size(); id++) {
+    auto it = this->ids.find(parentNames[id]);
+    // Padre sin fila propia: se añade como nodo aislado de profundidad 0
+    this->parents[id] =
+        it != this->ids.end() ? it->second : addValue(parentNames[id]);
+  }
+
+  const int n = this->values.size();
+  auto byValue = [this](const int a, const int b) {
+    return this->values[a] < this->values[b];
+  };
+
+  // Children ordered by value, without duplicates
+  size_t edges = 0;
+  for (vector<int> &children : this->childrenIds) {
+    sort(children.begin(), children.end(), byValue);
+    children.erase(unique(children.begin(), children.end()), children.end());
+    edges += children.size();
+  }
+
+  // Position of each node among the children of its parent
+  this->childSlots.assign(n, -1);
+  for (int id = 0; id < n; id++) {
+    for (size_t i = 0; i < this->childrenIds[id].size(); i++)
+      this->childSlots[this->childrenIds[id][i]] = i;
+  }
+
+  // Nodes of each level, ordered by value
+  for (int id = 0; id < n; id++)
+    this->levels[this->depths[id]].emplace_back(id);
+  for (auto &[depth, nodes] : this->levels)
+    sort(nodes.begin(), nodes.end(), byValue);
+
+  // Tree height
+  this->height = 0;
+  for (const int leaf : this->leafIds)
+    this->height = max(this->height, this->depths[leaf] + 1);
+
+  // La relación padre-hijo es un árbol si cada arista de hijos coincide con
+  // el padre del hijo y baja exactamente un nivel
+  size_t nonRoots = 0;
+  for (int id = 0; id < n; id++) {
+    if (this->parents[id] != id)
+      nonRoots++;
+    for (const int child : this->childrenIds[id]) {
+      if (child == id || this->parents[child] != id ||
+          this->depths[child] != this->depths[id] + 1)
+        this->consistent = false;
+    }
+  }
+  if (edges != nonRoots)
+    this->consistent = false;
+
+  // Maximum depth of the descendants of each node
+  this->maxDescendantDepths.assign(n, INT_MIN);
+  vector<char> state(n, 0);
+  vector<pair<int, size_t>> stack;
+  for (int start = 0; start < n; start++) {
+    if (state[start])
+      continue;
+    stack.emplace_back(start, 0);
+    state[start] = 1;
+    while (!stack.empty()) {
+      auto &[id, next] = stack.back();
+      if (next < this->childrenIds[id].size()) {
+        const int child = this->childrenIds[id][next++];
+        if (state[child] == 0) {
+          state[child] = 1;
+          stack.emplace_back(child, 0);
+        }
+        continue;
+      }
+
+      int maxDepth = INT_MIN;
+      for (const int child : this->childrenIds[id])
+        maxDepth = max({maxDepth, this->depths[child],
+                        this->maxDescendantDepths[child]});
+      this->maxDescendantDepths[id] = maxDepth;
+      state[id] = 2;
+      stack.pop_back();
+    }
+  }
+
+  // Height of the subtree of each node
+  this->subTreeHeights.assign(n, 1);
+  for (int id = 0; id < n; id++) {
+    int maxDepth = this->depths[id];
+    for (const int child : this->childrenIds[id])
+      maxDepth = max(maxDepth, this->maxDescendantDepths[child]);
+    this->subTreeHeights[id] = maxDepth - this->depths[id] + 1;
+  }
+
+  // Level-major ancestor table: ancestors[level * size + node]
+  this->ancestors.assign((size_t)this->height * n, -1);
+  for (int node = 0; node < n; node++) {
+    int id = node;
+    for (int steps = 0; steps < n; steps++) {
+      const int level = this->depths[id];
+      if (level >= 0 && level < this->height)
+        this->ancestors[(size_t)level * n + node] = id;
+      if (this->parents[id] == id)
+        break;
+      id = this->parents[id];
+    }
+  }
+}
+
+/*! Devuelve el número de nodos de la jerarquía.
+  \return número de nodos.
+*/
+int HierarchyIndex::size() const { return this->values.size(); }
+
+/*! Busca el identificador de un valor.
+  \param value valor del nodo.
+  \return identificador del nodo, o -1 si no se encuentra presente.
+*/
+int HierarchyIndex::find(const string &value) const {
+  auto it = this->ids.find(value);
+  return it == this->ids.end() ? -1 : it->second;
+}
+
+/*! Devuelve el valor de un nodo.
+  \param id identificador del nodo.
+  \return valor del nodo.
+*/
+const string &HierarchyIndex::value(int id) const { return this->values[id]; }
+
+/*! Devuelve el padre de un nodo. El padre de la raíz es ella misma.
+  \param id identificador del nodo.
+  \return identificador del nodo padre.
+*/
+int HierarchyIndex::parent(int id) const { return this->parents[id]; }
+
+/*! Devuelve la profundidad de un nodo.
+  \param id identificador del nodo.
+  \return profundidad del nodo.
+*/
+int HierarchyIndex::depth(int id) const { return this->depths[id]; }
+
+/*! Devuelve el número de hojas descendientes de un nodo.
+  \param id identificador del nodo.
+  \return número de hojas.
+*/
+int HierarchyIndex::numSubTreeLeaves(int id) const {
+  return this->leafCounts[id];
+}
+
+/*! Determina si un nodo es una hoja.
+  \param id identificador del nodo.
+  \return true si el nodo es una hoja.
+*/
+bool HierarchyIndex::isLeaf(int id) const { return this->leafFlags[id]; }
+
+/*! Devuelve los hijos directos de un nodo, ordenados por valor.
+  \param id identificador del nodo.
+  \return identificadores de los hijos.
+*/
+const vector<int> &HierarchyIndex::children(int id) const {
+  return this->childrenIds[id];
+}
+
+/*! Devuelve la mayor profundidad de entre los descendientes de un nodo.
+  \param id identificador del nodo.
+  \return profundidad máxima, o INT_MIN si el nodo no tiene hijos.
+*/
+int HierarchyIndex::maxDescendantDepth(int id) const {
+  return this->maxDescendantDepths[id];
+}
+
+/*! Devuelve los nodos de un nivel de profundidad, ordenados por valor.
+  \param depth profundidad.
+  \return identificadores de los nodos.
+*/
+const vector<int> &HierarchyIndex::nodesInLevel(int depth) const {
+  static const vector<int> empty;
+  auto it = this->levels.find(depth);
+  return it == this->levels.end() ? empty : it->second;
+}
+
+/*! Devuelve la raíz de la jerarquía.
+  \return identificador de la raíz, o -1 si la jerarquía está vacía.
+*/
+int HierarchyIndex::getRoot() const { return this->rootId; }
+
+/*! Devuelve la altura de la jerarquía.
+  \return altura.
+*/
+int HierarchyIndex::getHeight() const { return this->height; }
+
+/*! Devuelve el número de hojas de la jerarquía.
+  \return número de hojas.
+*/
+int HierarchyIndex::numLeaves() const { return this->leafIds.size(); }
+
+/*! Devuelve la altura del subárbol del que el nodo dado es raíz.
+  \param id identificador del nodo.
+  \return altura del subárbol.
+*/
+int HierarchyIndex::subTreeHeight(int id) const {
+  return this->subTreeHeights[id];
+}
+
+/*! Devuelve el ancestro de un nodo en un nivel dado.
+  \param id identificador del nodo.
+  \param level nivel de profundidad.
+  \return identificador del ancestro, o -1 si no existe.
+*/
+int HierarchyIndex::ancestor(int id, int level) const {
+  if (level < 0 || level >= this->height)
+    return -1;
+  return this->ancestors[(size_t)level * this->values.size() + id];
+}
+
+/*! Calcula el ancestro común más profundo de dos nodos.
+  \param a identificador del primer nodo.
+  \param b identificador del segundo nodo.
+  \return identificador del ancestro común.
+*/
+int HierarchyIndex::lowestCommonAncestor(int a, int b) const {
+  if (a == b)
+    return a;
+  if (!this->consistent)
+    return searchCommonAncestor({a, b});
+
+  // Distintas raíces: se devuelve la raíz del primer nodo
+  if (ancestor(a, 0) != ancestor(b, 0))
+    return ancestor(a, 0);
+
+  int low = 0, high = min(this->depths[a], this->depths[b]);
+  while (low < high) {
+    const int mid = (low + high + 1) / 2;
+    if (ancestor(a, mid) == ancestor(b, mid))
+      low = mid;
+    else
+      high = mid - 1;
+  }
+
+  return ancestor(a, low);
+}
+
+/*! Calcula el ancestro común más profundo de un conjunto de nodos. Como los
+    ancestros de todos los nodos coinciden en un nivel si coinciden en el
+    nivel inferior, se realiza una búsqueda binaria sobre los niveles de la
+    tabla de ancestros: O(n log h).
+  \param ids identificadores de los nodos.
+  \return identificador del ancestro común, o -1 si la lista está vacía.
+*/
+int HierarchyIndex::lowestCommonAncestor(const vector<int> &ids) const {
+  if (ids.empty())
+    return -1;
+
+  // Valores repetidos
+  vector<int> nodes = ids;
+  sort(nodes.begin(), nodes.end());
+  nodes.erase(unique(nodes.begin(), nodes.end()), nodes.end());
+  if (nodes.size() == 1)
+    return nodes[0];
+
+  if (!this->consistent)
+    return searchCommonAncestor(nodes);
+
+  int minDepth = INT_MAX;
+  for (const int id : nodes)
+    minDepth = min(minDepth, this->depths[id]);
+
+  auto sameAncestor = [this, &nodes](const int level) {
+    const int first = ancestor(nodes[0], level);
+    for (const int id : nodes) {
+      if (ancestor(id, level) != first)
+        return false;
+    }
+    return true;
+  };
+
+  // Distintas raíces: se devuelve la raíz del primer nodo
+  if (!sameAncestor(0))
+    return ancestor(nodes[0], 0);
+
+  int low = 0, high = minDepth;
+  while (low < high) {
+    const int mid = (low + high + 1) / 2;
+    if (sameAncestor(mid))
+      low = mid;
+    else
+      high = mid - 1;
+  }
+
+  return ancestor(nodes[0], low);
+}
+
+/*! Calcula el ancestro común de un conjunto de nodos recorriendo la cadena
+    de padres. Se emplea cuando las relaciones de la jerarquía no forman un
+    árbol.
+  \param nodes identificadores de los nodos.
+  \return identificador del ancestro común.
+*/
+int HierarchyIndex::searchCommonAncestor(const vector<int> &nodes) const {
+  const int n = this->values.size();
+
+  int common = nodes[0];
+  for (size_t i = 1; i < nodes.size(); i++) {
+    vector<bool> chain(n, false);
+    int id = common;
+    for (int steps = 0; steps < n; steps++) {
+      chain[id] = true;
+      if (this->parents[id] == id)
+        break;
+      id = this->parents[id];
+    }
+    const int root = id;
+
+    id = nodes[i];
+    for (int steps = 0; steps < n && !chain[id]; steps++)
+      id = this->parents[id];
+    common = chain[id] ? id : root;
+  }
+
+  return common;
+}
+
+/*! Determina si un nodo es descendiente (estricto) de otro.
+  \param node identificador del posible ancestro.
+  \param target identificador del posible descendiente.
+  \return true si target es descendiente de node.
+*/
+bool HierarchyIndex::isDescendant(int node, int target) const {
+  if (!this->consistent)
+    return searchDescendant(node, target);
+
+  if (node == target || this->depths[target] <= this->depths[node])
+    return false;
+
+  return ancestor(target, this->depths[node]) == node;
+}
+
+/*! Devuelve la posición, entre los hijos directos de un nodo, del hijo que
+    contiene a otro nodo (el propio hijo o uno de sus descendientes).
+  \param node identificador del nodo.
+  \param target identificador del nodo contenido.
+  \return posición del hijo, o -1 si target no desciende de node.
+*/
+int HierarchyIndex::childSlot(int node, int target) const {
+  if (node == -1 || target == -1)
+    return -1;
+
+  if (!this->consistent) {
+    const vector<int> &children = this->childrenIds[node];
+    for (size_t i = 0; i < children.size(); i++) {
+      if (children[i] == target || searchDescendant(children[i], target))
+        return i;
+    }
+    return -1;
+  }
+
+  const int level = this->depths[node] + 1;
+  if (this->depths[target] < level)
+    return -1;
+
+  const int child = ancestor(target, level);
+  if (child == -1 || this->parents[child] != node)
+    return -1;
+  return this->childSlots[child];
+}
+
+/*! Recorre los hijos de un nodo buscando un descendiente. Se emplea cuando
+    las relaciones de la jerarquía no forman un árbol.
+  \param node identificador del posible ancestro.
+  \param target identificador del posible descendiente.
+  \return true si target es descendiente de node.
+*/
+bool HierarchyIndex::searchDescendant(int node, int target) const {
+  vector<bool> visited(this->values.size(), false);
+  vector<int> stack = {node};
+  while (!stack.empty()) {
+    const int id = stack.back();
+    stack.pop_back();
+    for (const int child : this->childrenIds[id]) {
+      if (child == target)
+        return true;
+      if (!visited[child]) {
+        visited[child] = true;
+        stack.emplace_back(child);
+      }
+    }
+  }
+  return false;
+}
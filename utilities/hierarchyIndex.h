@@ -0,0 +1,75 @@
+/*! \file hierarchyIndex.h
+    \brief Fichero de cabecera del archivo hierarchyIndex.cpp.
+*/
+
+#ifndef _HIERARCHYINDEX_H
+#define _HIERARCHYINDEX_H
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/*! Clase HierarchyIndex. Representación compacta de una jerarquía: cada valor
+    se identifica por un entero y sus relaciones (padre, profundidad, número
+    de hojas, hijos) se almacenan en vectores indexados por dicho entero.
+    Incluye además una tabla, organizada por niveles, con el ancestro de cada
+    nodo en cada nivel del árbol, que permite resolver los ancestros comunes
+    y el hijo de un nodo que contiene a cada valor sin recorrer la
+    jerarquía.
+*/
+class HierarchyIndex {
+private:
+  vector<string> values;
+  unordered_map<string, int> ids;
+  vector<int> parents;
+  vector<int> depths;
+  vector<int> leafCounts;
+  vector<bool> leafFlags;
+  vector<vector<int>> childrenIds;
+  vector<int> maxDescendantDepths;
+  map<int, vector<int>> levels;
+  vector<int> subTreeHeights;
+  vector<int> leafIds;
+  vector<int> ancestors;
+  vector<int> childSlots;
+  int rootId = -1;
+  int height = 0;
+  bool consistent = true;
+
+  int addValue(const string &value);
+  void addLeave(const string &value, const string &parent, int depth,
+                vector<string> &parentNames);
+  int addNode(const string &value, int child, const string *parent,
+              vector<string> &parentNames);
+  void buildIndexes(const vector<string> &parentNames);
+  bool searchDescendant(int node, int target) const;
+  int searchCommonAncestor(const vector<int> &nodes) const;
+
+public:
+  HierarchyIndex();
+  HierarchyIndex(const vector<vector<string>> &hierarchy);
+  int size() const;
+  int find(const string &value) const;
+  const string &value(int id) const;
+  int parent(int id) const;
+  int depth(int id) const;
+  int numSubTreeLeaves(int id) const;
+  bool isLeaf(int id) const;
+  const vector<int> &children(int id) const;
+  int maxDescendantDepth(int id) const;
+  const vector<int> &nodesInLevel(int depth) const;
+  int getRoot() const;
+  int getHeight() const;
+  int numLeaves() const;
+  int subTreeHeight(int id) const;
+  int ancestor(int id, int level) const;
+  int lowestCommonAncestor(int a, int b) const;
+  int lowestCommonAncestor(const vector<int> &ids) const;
+  bool isDescendant(int node, int target) const;
+  int childSlot(int node, int target) const;
+};
+
+#endif
@@ -0,0 +1,71 @@
+/*! \file hierarchyRegistry.cpp
+    \brief Fichero que contiene la clase HierarchyRegistry, que almacena las
+           jerarquías y los árboles jerárquicos compartidos por todo el
+           programa.
+*/
+
+#include "hierarchyRegistry.h"
+#include "hierarchy.h"
+
+/*! Constructor por defecto de la clase HierarchyRegistry (registro vacío).
+  \return instancia del registro.
+*/
+HierarchyRegistry::HierarchyRegistry() {}
+
+/*! Constructor de la clase HierarchyRegistry. Construye el árbol jerárquico
+    de cada qid categórico.
+  \param hierarchies tablas de jerarquía, tal y como las devuelve
+                     readDirectory.
+  \param catQids índices de los qids categóricos.
+  \param transposed indica si las tablas se han leído transpuestas (una fila
+                    por nivel de generalización).
+  \return instancia del registro.
+*/
+HierarchyRegistry::HierarchyRegistry(
+    map<int, vector<vector<string>>> hierarchies, const vector<int> &catQids,
+    const bool transposed) {
+  this->hierarchies = move(hierarchies);
+  for (const int &qid : catQids) {
+    const vector<vector<string>> &hierarchy = getHierarchy(qid);
+    this->trees[qid] =
+        transposed ? Tree(transpose(hierarchy)) : Tree(hierarchy);
+  }
+}
+
+/*! Devuelve todas las tablas de jerarquía.
+  \return tablas de jerarquía, indexadas por atributo.
+*/
+const map<int, vector<vector<string>>> &
+HierarchyRegistry::getHierarchies() const {
+  return this->hierarchies;
+}
+
+/*! Devuelve la tabla de jerarquía de un atributo.
+  \param att índice del atributo.
+  \return tabla de jerarquía.
+*/
+const vector<vector<string>> &
+HierarchyRegistry::getHierarchy(const int att) const {
+  auto it = this->hierarchies.find(att);
+  if (it == this->hierarchies.end())
+    throw "Error: Hierarchy not found";
+  return it->second;
+}
+
+/*! Devuelve los árboles jerárquicos de los qids categóricos.
+  \return árboles jerárquicos, indexados por atributo.
+*/
+const map<int, Tree> &HierarchyRegistry::getTrees() const {
+  return this->trees;
+}
+
+/*! Devuelve el árbol jerárquico de un qid categórico.
+  \param att índice del atributo.
+  \return árbol jerárquico.
+*/
+const Tree &HierarchyRegistry::getTree(const int att) const {
+  auto it = this->trees.find(att);
+  if (it == this->trees.end())
+    throw "Error: Hierarchy tree not found";
+  return it->second;
+}
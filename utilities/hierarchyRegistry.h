@@ -0,0 +1,36 @@
+/*! \file hierarchyRegistry.h
+    \brief Fichero de cabecera del archivo hierarchyRegistry.cpp.
+*/
+
+#ifndef _HIERARCHYREGISTRY_H
+#define _HIERARCHYREGISTRY_H
+
+#include "tree.h"
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*! Clase HierarchyRegistry. Registro de solo lectura con las tablas de
+    jerarquía leídas del directorio de datos y el árbol jerárquico de cada
+    qid categórico. Se construye una única vez por ejecución y el resto del
+    programa accede a él por referencia, de modo que las jerarquías y los
+    árboles nunca se copian.
+*/
+class HierarchyRegistry {
+private:
+  map<int, vector<vector<string>>> hierarchies;
+  map<int, Tree> trees;
+
+public:
+  HierarchyRegistry();
+  HierarchyRegistry(map<int, vector<vector<string>>> hierarchies,
+                    const vector<int> &catQids, const bool transposed = false);
+  const map<int, vector<vector<string>>> &getHierarchies() const;
+  const vector<vector<string>> &getHierarchy(const int att) const;
+  const map<int, Tree> &getTrees() const;
+  const Tree &getTree(const int att) const;
+};
+
+#endif
@@ -12,9 +12,10 @@
   \param clusters clases de equivalencia de las que se componen los datos
                   anonimizados.
   \param tableSize cardinalidad de la tabla original.
+  \return valor de la métrica DM.
 */
-void calculateDM(vector<vector<vector<string>>> clusters, const int tableSize,
-                 const int K) {
+long double calculateDM(vector<vector<vector<string>>> clusters,
+                        const int tableSize, const int K) {
   long double dm = 0;
   for (const vector<vector<string>> &cluster : clusters) {
     if ((long double)cluster.size() >= K)
@@ -25,6 +26,8 @@ void calculateDM(vector<vector<vector<string>>> clusters, const int tableSize,
 
   cout << "\t* DM: ";
   cout << fixed << setprecision(3) << dm << endl;
+
+  return dm;
 }
 
 /*! Calcula y muestra por pantalla el valor de la métrica Equivalent Class
@@ -33,15 +36,18 @@ void calculateDM(vector<vector<vector<string>>> clusters, const int tableSize,
                   anonimizados.
   \param tableSize cardinalidad de la tabla original.
   \param K parámetro de la k-anonimidad.
+  \return valor de la métrica CAvg.
 */
-void calculateCAVG(vector<vector<vector<string>>> clusters, const int tableSize,
-                   const int K) {
+long double calculateCAVG(vector<vector<vector<string>>> clusters,
+                          const int tableSize, const int K) {
   const long double denom = (long double)(clusters.size() * K);
   const long double cavg = (denom == 0) ? 0 : tableSize / denom;
 
   cout << "\t* CAvg: ";
   cout << fixed << setprecision(3);
   cout << cavg << endl;
+
+  return cavg;
 }
 
 /*! Calcula el valor máximo de entre una lista de valores numéricos dados.
@@ -148,7 +154,7 @@ long double calculateNumGenILoss(const string entry, vector<string> entries,
   \param tree árbol jerárquico del atributo.
   \return valor de la métrica.
 */
-long double calculateCatGenILoss(const string entry, Tree tree) {
+long double calculateCatGenILoss(const string &entry, const Tree &tree) {
 
   const int directChildren = tree.getDirectChildren(entry).size();
   const int childrenInLevel = tree.getChildrenInLevel(entry).size();
@@ -168,11 +174,13 @@ long double calculateCatGenILoss(const string entry, Tree tree) {
   \param catQids índice de los qids categóricos.
   \param numQids índice de los qids numéricos.
   \param tableSize cardinalidad de la tabla original.
+  \return valor de la métrica GenILoss.
 */
-void calculateGenILoss(vector<vector<string>> transposedDataset,
-                       map<int, Tree> trees, const vector<int> allQids,
-                       const vector<int> catQids, const vector<int> numQids,
-                       const int tableSize) {
+long double calculateGenILoss(vector<vector<string>> transposedDataset,
+                              const map<int, Tree> &trees,
+                              const vector<int> allQids,
+                              const vector<int> catQids,
+                              const vector<int> numQids, const int tableSize) {
   const long double initialLoss =
       1.0 / (transposedDataset[0].size() * (catQids.size() + numQids.size()));
   long double loss = 0;
@@ -218,10 +226,12 @@ void calculateGenILoss(vector<vector<string>> transposedDataset,
   for (size_t i = 0; i < catFreqs.size(); i++) {
     // Calculate Attributes GenILoss
     for (const auto &[k, v] : catFreqs[i])
-      loss += calculateCatGenILoss(k, trees[catQids[i]]) * v;
+      loss += calculateCatGenILoss(k, findTree(trees, catQids[i])) * v;
   }
 
   cout << "\t* GenILoss: ";
   cout << fixed << setprecision(3);
   cout << initialLoss * loss << endl;
+
+  return initialLoss * loss;
 }
@@ -13,12 +13,19 @@
 
 using namespace std;
 
-void calculateDM(vector<vector<vector<string>>> clusters, const int tableSize,
-                 const int K);
-void calculateCAVG(vector<vector<vector<string>>> clusters, const int tableSize,
-                   const int K);
-void calculateGenILoss(vector<vector<string>> transposedDataset,
-                       map<int, Tree> trees, const vector<int> allQids,
-                       const vector<int> catQids, const vector<int> numQids,
-                       const int tableSize);
+long double calculateDM(vector<vector<vector<string>>> clusters,
+                        const int tableSize, const int K);
+long double calculateCAVG(vector<vector<vector<string>>> clusters,
+                          const int tableSize, const int K);
+long double calculateMaxNumValue(vector<string> entries);
+long double calculateMinNumValue(vector<string> entries);
+long double calculateNumGenILoss(const string entry, vector<string> entries,
+                                 const long double globalMax,
+                                 const long double globalMin);
+long double calculateCatGenILoss(const string &entry, const Tree &tree);
+long double calculateGenILoss(vector<vector<string>> transposedDataset,
+                              const map<int, Tree> &trees,
+                              const vector<int> allQids,
+                              const vector<int> catQids,
+                              const vector<int> numQids, const int tableSize);
 #endif
@@ -0,0 +1,227 @@
+/*! \file metricsAccumulator.cpp
+    \brief Fichero que contiene la clase MetricsAccumulator, que calcula las
+           métricas GCP, DM, CAvg y GenILoss clase a clase.
+*/
+
+#include "metricsAccumulator.h"
+
+/*! Constructor de la clase MetricsAccumulator.
+  \param trees árboles jerárquicos de los qids categóricos.
+  \param weights lista de pesos correspondientes a cada atributo qid.
+  \param allQids índices de los atributos qids.
+  \param numQids índices de los qids considerados numéricos en las métricas.
+  \param catQids índices de los qids considerados categóricos en las
+                 métricas.
+  \param tableSize cardinalidad de la tabla original.
+  \param K parámetro del modelo de privacidad k-anonymity.
+  \return instancia del acumulador.
+*/
+MetricsAccumulator::MetricsAccumulator(
+    const map<int, Tree> &trees, const vector<double> &weights,
+    const vector<int> &allQids, const vector<int> &numQids,
+    const vector<int> &catQids, const int tableSize, const int K) {
+  this->trees = &trees;
+  this->weights = weights;
+  this->allQids = allQids;
+  this->numQids = numQids;
+  this->catQids = catQids;
+  this->tableSize = tableSize;
+  this->K = K;
+  this->records = 0;
+  this->numMax.assign(numQids.size(), -1);
+  this->numMin.assign(numQids.size(), -1);
+  this->dm = 0;
+  this->freqs.resize(allQids.size());
+}
+
+/*! Devuelve la posición de un qid en la lista de qids numéricos.
+  \param qid índice del atributo qid.
+  \return posición del qid, o -1 si no es numérico.
+*/
+int MetricsAccumulator::numPosition(int qid) const {
+  auto it = find(this->numQids.begin(), this->numQids.end(), qid);
+  return it == this->numQids.end() ? -1 : it - this->numQids.begin();
+}
+
+/*! Añade una clase de equivalencia a las métricas.
+  \param cluster registros anonimizados de la clase.
+*/
+void MetricsAccumulator::add(const vector<vector<string>> &cluster) {
+  const size_t size = cluster.size();
+  this->records += size;
+  this->sizes.emplace_back(size);
+
+  // DM
+  if ((long double)size >= this->K)
+    this->dm += pow(size, 2.0);
+  else
+    this->dm += this->tableSize * size;
+
+  // NCP de los atributos numéricos: rango de la clase y rango global
+  vector<pair<long double, long double>> ranges(this->numQids.size());
+  for (size_t i = 0; i < this->numQids.size() && size > 0; i++) {
+    long double low = 0, high = 0;
+    for (size_t j = 0; j < size; j++) {
+      const string &value = cluster[j][this->numQids[i]];
+      long double splitMin, splitMax;
+      try {
+        const size_t index = value.find('~');
+        if (index != string::npos) {
+          splitMin = stod(value.substr(0, index));
+          splitMax = stod(value.substr(index + 1, value.size()));
+        } else
+          splitMin = splitMax = stod(value);
+      } catch (const exception &e) {
+        throw "\nError, some categorical attribute "
+              " can't be treated as numerical\n";
+      }
+
+      if (j == 0 || splitMin < low)
+        low = splitMin;
+      if (j == 0 || splitMax > high)
+        high = splitMax;
+    }
+    ranges[i] = make_pair(low, high);
+
+    if (high > this->numMax[i] || this->numMax[i] == -1)
+      this->numMax[i] = high;
+    if (low < this->numMin[i] || this->numMin[i] == -1)
+      this->numMin[i] = low;
+  }
+  this->numRanges.emplace_back(ranges);
+
+  // NCP de los atributos categóricos
+  vector<long double> ncps(this->allQids.size(), 0);
+  for (size_t i = 0; i < this->allQids.size(); i++) {
+    const int qid = this->allQids[i];
+    if (numPosition(qid) != -1)
+      continue;
+
+    vector<string> values;
+    values.reserve(size);
+    for (const auto &record : cluster)
+      values.emplace_back(record[qid]);
+    ncps[i] = calculateCatNCP(values, findTree(*this->trees, qid));
+  }
+  this->catNCPs.emplace_back(ncps);
+
+  // Frecuencias de los valores generalizados (GenILoss)
+  for (size_t i = 0; i < this->allQids.size(); i++) {
+    for (const auto &record : cluster)
+      this->freqs[i][record[this->allQids[i]]] += 1;
+  }
+}
+
+/*! Devuelve el número de clases de equivalencia añadidas.
+  \return número de clases.
+*/
+size_t MetricsAccumulator::numClusters() const { return this->sizes.size(); }
+
+/*! Calcula y muestra por pantalla el valor de la métrica GCP.
+  \return valor de la métrica GCP.
+*/
+long double MetricsAccumulator::calculateGCP() const {
+  long double gcp = 0;
+  for (size_t c = 0; c < this->sizes.size(); c++) {
+    long double ncp = 0.0;
+    for (size_t i = 0; i < this->allQids.size(); i++) {
+      const int pos = numPosition(this->allQids[i]);
+      if (pos != -1) {
+        // Numeric attributes
+        const long double range =
+            this->numRanges[c][pos].second - this->numRanges[c][pos].first;
+        const long double globalRange = this->numMax[pos] - this->numMin[pos];
+        ncp += (globalRange == 0 ? range : range / globalRange) *
+               this->weights[i];
+      } else {
+        // Categorical attributes
+        if (this->catNCPs[c][i] == -1)
+          continue;
+        ncp += this->catNCPs[c][i] * this->weights[i];
+      }
+    }
+    ncp *= this->allQids.size();
+    gcp += (long double)(this->sizes[c] * ncp);
+  }
+  gcp /= (this->allQids.size() * this->tableSize);
+
+  // Show only 3 decimals
+  cout << "\t* GCP: ";
+  cout << fixed << setprecision(3) << gcp << endl;
+
+  return gcp;
+}
+
+/*! Calcula y muestra por pantalla el valor de la métrica DM.
+  \return valor de la métrica DM.
+*/
+long double MetricsAccumulator::calculateDM() const {
+  cout << "\t* DM: ";
+  cout << fixed << setprecision(3) << this->dm << endl;
+
+  return this->dm;
+}
+
+/*! Calcula y muestra por pantalla el valor de la métrica CAvg.
+  \return valor de la métrica CAvg.
+*/
+long double MetricsAccumulator::calculateCAVG() const {
+  const long double denom = (long double)(this->sizes.size() * this->K);
+  const long double cavg = (denom == 0) ? 0 : this->tableSize / denom;
+
+  cout << "\t* CAvg: ";
+  cout << fixed << setprecision(3);
+  cout << cavg << endl;
+
+  return cavg;
+}
+
+/*! Calcula y muestra por pantalla el valor de la métrica GenILoss a partir
+    de las frecuencias de los valores generalizados.
+  \return valor de la métrica GenILoss.
+*/
+long double MetricsAccumulator::calculateGenILoss() const {
+  long double loss = 0, initialLoss = 0;
+
+  if (this->records > 0) {
+    initialLoss =
+        1.0 / (this->records * (this->catQids.size() + this->numQids.size()));
+
+    vector<const map<string, int> *> catFreqs, numFreqs;
+    vector<tuple<long double, long double>> numGlobal;
+    for (size_t i = 0; i < this->allQids.size(); i++) {
+      const int idx = this->allQids[i];
+      if (numPosition(idx) != -1) {
+        vector<string> values;
+        for (const auto &entry : this->freqs[i])
+          values.emplace_back(entry.first);
+        numFreqs.emplace_back(&this->freqs[i]);
+        numGlobal.emplace_back(calculateMaxNumValue(values),
+                               calculateMinNumValue(values));
+      } else if (find(this->catQids.begin(), this->catQids.end(), idx) !=
+                 this->catQids.end())
+        catFreqs.emplace_back(&this->freqs[i]);
+    }
+
+    // Numerical Attributes
+    for (size_t i = 0; i < numFreqs.size(); i++) {
+      long double globalMax = get<0>(numGlobal[i]);
+      long double globalMin = get<1>(numGlobal[i]);
+      for (const auto &[k, v] : *numFreqs[i])
+        loss += calculateNumGenILoss(k, {}, globalMax, globalMin) * v;
+    }
+
+    // Categorical Attributes
+    for (size_t i = 0; i < catFreqs.size(); i++) {
+      const Tree &tree = findTree(*this->trees, this->catQids[i]);
+      for (const auto &[k, v] : *catFreqs[i])
+        loss += calculateCatGenILoss(k, tree) * v;
+    }
+  }
+
+  cout << "\t* GenILoss: ";
+  cout << fixed << setprecision(3);
+  cout << initialLoss * loss << endl;
+
+  return initialLoss * loss;
+}
@@ -0,0 +1,62 @@
+/*! \file metricsAccumulator.h
+    \brief Fichero de cabecera del archivo metricsAccumulator.cpp.
+*/
+
+#ifndef _METRICSACCUMULATOR_H
+#define _METRICSACCUMULATOR_H
+
+#include "analysis.h"
+#include "metrics.h"
+#include "tree.h"
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*! Clase MetricsAccumulator. Calcula las métricas GCP, DM, CAvg y GenILoss
+    a medida que se obtienen las clases de equivalencia, de modo que no es
+    necesario conservar el conjunto de datos anonimizado completo. De cada
+    clase se guarda únicamente su tamaño, el valor NCP de cada qid
+    categórico y el rango de cada qid numérico; para GenILoss se acumula la
+    frecuencia de cada valor generalizado. Los valores obtenidos coinciden
+    con los de calculateGCP, calculateDM, calculateCAVG y calculateGenILoss.
+*/
+class MetricsAccumulator {
+private:
+  const map<int, Tree> *trees;
+  vector<double> weights;
+  vector<int> allQids, numQids, catQids;
+  int tableSize, K;
+  size_t records;
+
+  // GCP
+  vector<size_t> sizes;
+  vector<vector<long double>> catNCPs;
+  vector<vector<pair<long double, long double>>> numRanges;
+  vector<long double> numMax, numMin;
+
+  // DM
+  long double dm;
+
+  // GenILoss
+  vector<map<string, int>> freqs;
+
+  int numPosition(int qid) const;
+
+public:
+  // Constructor
+  MetricsAccumulator(const map<int, Tree> &trees,
+                     const vector<double> &weights,
+                     const vector<int> &allQids, const vector<int> &numQids,
+                     const vector<int> &catQids, const int tableSize,
+                     const int K);
+  void add(const vector<vector<string>> &cluster);
+  size_t numClusters() const;
+  long double calculateGCP() const;
+  long double calculateDM() const;
+  long double calculateCAVG() const;
+  long double calculateGenILoss() const;
+};
+
+#endif
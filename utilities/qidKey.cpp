@@ -0,0 +1,224 @@
+/*! \file qidKey.cpp
+    \brief Fichero que contiene la clase QidKeyEncoder, responsable de
+           codificar la tupla de qids de cada registro como una única clave
+           numérica y de obtener las clases de equivalencia a partir de ella.
+*/
+
+#include "qidKey.h"
+#include <algorithm>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+
+// Número de bits de cada dígito de la ordenación radix
+static const int DIGIT_BITS = 11;
+// Tamaño máximo del espacio de claves para utilizar una ordenación por conteo
+static const uint128_t COUNTING_MIN_SPACE = 1 << 16;
+
+/*! Agrupa una lista de registros ordenados por clave en clases de
+    equivalencia, creando una nueva clase cada vez que cambia la clave.
+  \param keys claves ordenadas.
+  \param rows registros en el mismo orden que las claves.
+  \return índices de los registros de cada clase de equivalencia.
+*/
+template <typename Key>
+static vector<vector<int>> splitClasses(const vector<Key> &keys,
+                                        const vector<int> &rows) {
+  vector<vector<int>> classes;
+  for (size_t i = 0; i < rows.size(); i++) {
+    if (i == 0 || keys[i] != keys[i - 1])
+      classes.emplace_back();
+    classes.back().emplace_back(rows[i]);
+  }
+  return classes;
+}
+
+//! Constructor vacio
+QidKeyEncoder::QidKeyEncoder(){};
+
+/*! Constructor.
+  \param radices número de valores distintos de cada qid.
+*/
+QidKeyEncoder::QidKeyEncoder(const vector<uint32_t> &radices) {
+  this->radices = radices;
+  this->strides.resize(radices.size());
+
+  // El último qid es el dígito menos significativo, de modo que el orden de
+  // las claves coincide con el orden lexicográfico de las tuplas de códigos
+  const uint128_t max = ~(uint128_t)0;
+  for (int j = radices.size() - 1; j >= 0; j--) {
+    const uint32_t radix = radices[j] == 0 ? 1 : radices[j];
+    this->strides[j] = this->keySpace;
+    if (this->keySpace > max / radix) {
+      this->overflow = true;
+      break;
+    }
+    this->keySpace *= radix;
+  }
+
+  this->wide = this->overflow || this->keySpace - 1 > UINT64_MAX;
+  for (uint128_t k = this->keySpace - 1; k != 0; k >>= 1)
+    this->keyBits++;
+}
+
+/*! Calcula la clave de cada registro.
+  \param columns códigos de cada uno de los qids.
+  \param numRows número de registros.
+  \param keys claves resultantes.
+*/
+template <typename Key>
+void QidKeyEncoder::encode(const vector<const uint32_t *> &columns,
+                           size_t numRows, vector<Key> &keys) const {
+  keys.assign(numRows, 0);
+  for (size_t j = 0; j < columns.size(); j++) {
+    const Key stride = (Key)this->strides[j];
+    const uint32_t *column = columns[j];
+    for (size_t i = 0; i < numRows; i++)
+      keys[i] += (Key)column[i] * stride;
+  }
+}
+
+/*! Obtiene las clases de equivalencia mediante una ordenación por conteo,
+    utilizada cuando el espacio de claves es reducido.
+  \param columns códigos de cada uno de los qids.
+  \param numRows número de registros.
+  \return índices de los registros de cada clase de equivalencia.
+*/
+vector<vector<int>>
+QidKeyEncoder::countingClasses(const vector<const uint32_t *> &columns,
+                               size_t numRows) const {
+  vector<uint64_t> keys;
+  encode(columns, numRows, keys);
+
+  vector<int> counts((size_t)this->keySpace, 0);
+  for (const uint64_t &key : keys)
+    counts[key]++;
+
+  vector<int> slots((size_t)this->keySpace, -1);
+  vector<vector<int>> classes;
+  for (size_t key = 0; key < counts.size(); key++) {
+    if (counts[key] == 0)
+      continue;
+    slots[key] = classes.size();
+    classes.emplace_back();
+    classes.back().reserve(counts[key]);
+  }
+
+  for (size_t i = 0; i < numRows; i++)
+    classes[slots[keys[i]]].emplace_back(i);
+
+  return classes;
+}
+
+/*! Obtiene las clases de equivalencia mediante una ordenación radix LSD
+    de las claves.
+  \param columns códigos de cada uno de los qids.
+  \param numRows número de registros.
+  \return índices de los registros de cada clase de equivalencia.
+*/
+template <typename Key>
+vector<vector<int>>
+QidKeyEncoder::sortedClasses(const vector<const uint32_t *> &columns,
+                             size_t numRows) const {
+  vector<Key> keys;
+  encode(columns, numRows, keys);
+  vector<int> rows(numRows);
+  iota(rows.begin(), rows.end(), 0);
+
+  // Cada pasada es estable, por lo que los registros de una misma clase
+  // mantienen su orden original
+  const size_t buckets = 1 << DIGIT_BITS;
+  vector<Key> auxKeys(numRows);
+  vector<int> auxRows(numRows);
+  vector<size_t> offsets(buckets);
+  for (int shift = 0; shift < this->keyBits; shift += DIGIT_BITS) {
+    fill(offsets.begin(), offsets.end(), 0);
+    for (const Key &key : keys)
+      offsets[(size_t)(key >> shift) & (buckets - 1)]++;
+
+    size_t sum = 0;
+    for (size_t &offset : offsets) {
+      const size_t count = offset;
+      offset = sum;
+      sum += count;
+    }
+
+    for (size_t i = 0; i < numRows; i++) {
+      const size_t pos = offsets[(size_t)(keys[i] >> shift) & (buckets - 1)]++;
+      auxKeys[pos] = keys[i];
+      auxRows[pos] = rows[i];
+    }
+    keys.swap(auxKeys);
+    rows.swap(auxRows);
+  }
+
+  return splitClasses(keys, rows);
+}
+
+/*! Obtiene las clases de equivalencia ordenando los registros
+    lexicográficamente. Utilizado únicamente si el espacio de claves
+    no cabe en 128 bits.
+  \param columns códigos de cada uno de los qids.
+  \param numRows número de registros.
+  \return índices de los registros de cada clase de equivalencia.
+*/
+vector<vector<int>>
+QidKeyEncoder::lexicographicClasses(const vector<const uint32_t *> &columns,
+                                    size_t numRows) const {
+  vector<int> rows(numRows);
+  iota(rows.begin(), rows.end(), 0);
+
+  auto compare = [&columns](const int r1, const int r2) {
+    for (const uint32_t *column : columns) {
+      if (column[r1] != column[r2])
+        return column[r1] < column[r2];
+    }
+    return false;
+  };
+  stable_sort(rows.begin(), rows.end(), compare);
+
+  vector<vector<int>> classes;
+  for (size_t i = 0; i < rows.size(); i++) {
+    if (i == 0 || compare(rows[i - 1], rows[i]))
+      classes.emplace_back();
+    classes.back().emplace_back(rows[i]);
+  }
+  return classes;
+}
+
+/*! Obtiene las clases de equivalencia de un conjunto de registros. Las
+    clases se devuelven en orden lexicográfico de sus tuplas de códigos.
+  \param columns códigos de cada uno de los qids.
+  \param numRows número de registros.
+  \return índices de los registros de cada clase de equivalencia.
+*/
+vector<vector<int>>
+QidKeyEncoder::equivalenceClasses(const vector<const uint32_t *> &columns,
+                                  size_t numRows) const {
+  if (numRows == 0)
+    return {};
+  if (this->overflow)
+    return lexicographicClasses(columns, numRows);
+  if (this->keySpace <= max(COUNTING_MIN_SPACE, (uint128_t)numRows * 2))
+    return countingClasses(columns, numRows);
+  if (!this->wide)
+    return sortedClasses<uint64_t>(columns, numRows);
+  return sortedClasses<uint128_t>(columns, numRows);
+}
+
+/*! Codifica los valores de una columna de un conjunto de datos como enteros
+    densos, asignados en orden de aparición.
+  \param dataset conjunto de datos.
+  \param col índice de la columna.
+  \param codes códigos resultantes de cada registro.
+  \return número de valores distintos de la columna.
+*/
+uint32_t encodeColumn(const vector<vector<string>> &dataset, const int col,
+                      vector<uint32_t> &codes) {
+  unordered_map<string_view, uint32_t> index;
+  codes.resize(dataset.size());
+  for (size_t i = 0; i < dataset.size(); i++)
+    codes[i] = index.emplace(dataset[i][col], index.size()).first->second;
+
+  return index.size();
+}
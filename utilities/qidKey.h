@@ -0,0 +1,56 @@
+/*! \file qidKey.h
+    \brief Fichero de cabecera del archivo qidKey.cpp.
+*/
+
+#ifndef _QIDKEY_H
+#define _QIDKEY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+typedef unsigned __int128 uint128_t;
+
+/*! Clase QidKeyEncoder. Empaqueta la tupla de códigos de los qids de un
+    registro en una única clave numérica en base mixta, donde la base de cada
+    qid es el número de valores distintos que puede tomar en su nivel de
+    generalización. Si el espacio de claves no cabe en 64 bits se utilizan
+    claves de 128 bits. Las clases de equivalencia se obtienen ordenando las
+    claves mediante un conteo (espacio de claves reducido) o una ordenación
+    radix LSD, en lugar de comparar cadenas de caracteres.
+*/
+class QidKeyEncoder {
+private:
+  vector<uint32_t> radices;
+  vector<uint128_t> strides;
+  uint128_t keySpace = 1;
+  int keyBits = 0;
+  bool wide = false;
+  bool overflow = false;
+
+  template <typename Key>
+  void encode(const vector<const uint32_t *> &columns, size_t numRows,
+              vector<Key> &keys) const;
+  vector<vector<int>> countingClasses(const vector<const uint32_t *> &columns,
+                                      size_t numRows) const;
+  template <typename Key>
+  vector<vector<int>> sortedClasses(const vector<const uint32_t *> &columns,
+                                    size_t numRows) const;
+  vector<vector<int>>
+  lexicographicClasses(const vector<const uint32_t *> &columns,
+                       size_t numRows) const;
+
+public:
+  QidKeyEncoder();
+  QidKeyEncoder(const vector<uint32_t> &radices);
+  vector<vector<int>>
+  equivalenceClasses(const vector<const uint32_t *> &columns,
+                     size_t numRows) const;
+};
+
+uint32_t encodeColumn(const vector<vector<string>> &dataset, const int col,
+                      vector<uint32_t> &codes);
+
+#endif
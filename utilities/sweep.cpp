@@ -0,0 +1,321 @@
+/*! \file sweep.cpp
+    \brief Fichero que contiene las funciones del modo batch, que permite
+           evaluar una lista de parámetros de los modelos de privacidad
+           leyendo el conjunto de datos y las jerarquías una única vez.
+
+    El fichero de configuración contiene pares clave = valor y una línea
+    "K L T" por cada ejecución (-1 si no se utiliza el modelo):
+
+        qids = age,education,marital-status
+        confatts = occupation
+        weights = 0.2,0.3,0.5
+        numeric = age
+        ordered = hours-per-week
+        supp = 1
+        output = sweep.csv
+        threads = 4
+        processes = 4
+        memory = 512
+        spill = /tmp
+        10 -1 -1
+        10 2 -1
+*/
+
+#include "sweep.h"
+#include "writeData.h"
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <thread>
+
+/*! Elimina los espacios al principio y al final de una cadena.
+  \param value cadena de caracteres.
+  \return cadena sin espacios.
+*/
+static string trim(const string &value) {
+  const size_t begin = value.find_first_not_of(" \t\r");
+  if (begin == string::npos)
+    return "";
+  const size_t end = value.find_last_not_of(" \t\r");
+  return value.substr(begin, end - begin + 1);
+}
+
+/*! Divide una lista de valores separados por comas.
+  \param value lista de valores.
+  \return valores de la lista.
+*/
+static vector<string> splitList(const string &value) {
+  vector<string> items;
+  stringstream stream(value);
+  string item;
+  while (getline(stream, item, ',')) {
+    item = trim(item);
+    if (!item.empty())
+      items.emplace_back(item);
+  }
+  return items;
+}
+
+/*! Comprueba si se ha solicitado el modo batch desde la línea de comandos
+    ([directorio] --batch [fichero de configuración]).
+  \param argc número de argumentos.
+  \param argv argumentos.
+  \return 1 si se debe ejecutar en modo batch, 0 si no es así.
+*/
+bool isBatchMode(int argc, char **argv) {
+  return argc == 4 && string(argv[2]) == "--batch";
+}
+
+/*! Lee el fichero de configuración de un barrido.
+  \param fname ruta del fichero de configuración.
+  \return configuración del barrido.
+*/
+SweepConfig readSweepConfig(const string &fname) {
+  ifstream fp(fname);
+  if (!fp.is_open())
+    throw "Error: Unable to open batch configuration file";
+
+  SweepConfig config;
+  vector<double> weights;
+  string line;
+  while (getline(fp, line)) {
+    line = trim(line.substr(0, line.find('#')));
+    if (line.empty())
+      continue;
+
+    const size_t eq = line.find('=');
+    if (eq == string::npos) {
+      // Línea "K L T"
+      SweepSetting setting;
+      stringstream stream(line);
+      string rest;
+      if (!(stream >> setting.K >> setting.L >> setting.T) || stream >> rest)
+        throw "Error: Batch settings should be written as \"K L T\"";
+      config.settings.emplace_back(setting);
+      continue;
+    }
+
+    const string key = trim(line.substr(0, eq));
+    const string value = trim(line.substr(eq + 1));
+    try {
+      if (key == "qids")
+        config.qidNames = splitList(value);
+      else if (key == "confatts")
+        config.confAttNames = splitList(value);
+      else if (key == "numeric")
+        config.numericNames = splitList(value);
+      else if (key == "ordered")
+        config.orderedNames = splitList(value);
+      else if (key == "weights") {
+        for (const string &weight : splitList(value))
+          weights.emplace_back(stod(weight));
+      } else if (key == "supp")
+        config.suppThreshold = stold(value);
+      else if (key == "output")
+        config.output = value;
+      else if (key == "threads")
+        config.threads = stoi(value);
+      else if (key == "processes")
+        config.processes = stoi(value);
+      else if (key == "memory")
+        config.memory = stoi(value);
+      else if (key == "spill")
+        config.spill = value;
+      else
+        throw "Error: Unknown key in batch configuration file";
+    } catch (const logic_error &) {
+      throw "Error: Invalid number in batch configuration file";
+    }
+  }
+
+  if (config.qidNames.empty())
+    throw "Error: Batch configuration file should define some qids";
+  if (config.settings.empty())
+    throw "Error: Batch configuration file should define some settings";
+  if (config.threads < 0)
+    throw "Error: Number of threads should be a non-negative number";
+  if (config.processes < 0)
+    throw "Error: Number of processes should be a non-negative number";
+  if (config.memory < 0)
+    throw "Error: Memory budget should be a non-negative number";
+  if (!weights.empty() && weights.size() != config.qidNames.size())
+    throw "Error: Batch configuration file should define one weight per qid";
+
+  // Los qids se ordenan por nombre, al igual que en el modo interactivo,
+  // manteniendo el peso asignado a cada uno
+  vector<size_t> order(config.qidNames.size());
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [&config](size_t a, size_t b) {
+    return config.qidNames[a] < config.qidNames[b];
+  });
+
+  vector<string> qidNames;
+  for (const size_t &i : order) {
+    qidNames.emplace_back(config.qidNames[i]);
+    if (!weights.empty())
+      config.weights.emplace_back(weights[i]);
+  }
+  if (set<string>(qidNames.begin(), qidNames.end()).size() != qidNames.size())
+    throw "Input Error: Qids should be unique. "
+          "Check if you repeated some of them.";
+  config.qidNames = qidNames;
+
+  set<string> confAtts(config.confAttNames.begin(), config.confAttNames.end());
+  if (confAtts.size() != config.confAttNames.size())
+    throw "Input Error: Confidential Attributes should be "
+          "unique. Check if you repeated some of them.";
+  config.confAttNames = vector<string>(confAtts.begin(), confAtts.end());
+
+  return config;
+}
+
+/*! Devuelve los pesos de cada qid. Si no se han definido, se asigna el
+    mismo peso a todos ellos.
+  \param config configuración del barrido.
+  \return pesos de los qids.
+*/
+vector<double> sweepWeights(const SweepConfig &config) {
+  if (config.weights.empty())
+    return vector<double>(config.qidNames.size(),
+                          1.0 / config.qidNames.size());
+
+  if (accumulate(config.weights.begin(), config.weights.end(), (float)0) !=
+      (float)1)
+    throw "Input Error: Weights must sum 1.";
+
+  return config.weights;
+}
+
+/*! Determina qué atributos se consideran numéricos en el cálculo de las
+    métricas, equivalente a readMetricsQids.
+  \param config configuración del barrido.
+  \param numQids índice de los qids numéricos.
+  \param catQids índice de los qids categóricos.
+  \param headers cabecera del fichero.
+  \return índices de los qids numéricos y categóricos.
+*/
+tuple<vector<int>, vector<int>>
+sweepMetricsQids(const SweepConfig &config, const vector<int> &numQids,
+                 const vector<int> &catQids, const vector<string> &headers) {
+  vector<int> numMetricsQids = numQids, catMetricsQids;
+  for (const int &qid : catQids) {
+    if (find(config.numericNames.begin(), config.numericNames.end(),
+             headers[qid]) != config.numericNames.end())
+      numMetricsQids.emplace_back(qid);
+    else
+      catMetricsQids.emplace_back(qid);
+  }
+
+  return make_tuple(numMetricsQids, catMetricsQids);
+}
+
+/*! Determina qué atributos sensibles utilizan la distancia ordenada en
+    t-closeness (atributos numéricos). El resto utilizan la distancia de
+    igualdad.
+  \param config configuración del barrido.
+  \param confAtts índices de los atributos sensibles.
+  \param headers cabecera del fichero.
+  \return índices de los atributos sensibles ordenados.
+*/
+vector<int> sweepOrderedAtts(const SweepConfig &config,
+                             const vector<int> &confAtts,
+                             const vector<string> &headers) {
+  vector<int> orderedAtts;
+  for (const string &name : config.orderedNames) {
+    auto it = find_if(confAtts.begin(), confAtts.end(),
+                      [&](const int &att) { return headers[att] == name; });
+    if (it == confAtts.end())
+      throw "Error: Ordered attributes should be confidential attributes";
+    orderedAtts.emplace_back(*it);
+  }
+
+  return orderedAtts;
+}
+
+/*! Comprueba que los parámetros de una ejecución son válidos, siguiendo
+    las mismas reglas que readParameters.
+  \param setting parámetros de los modelos de privacidad.
+  \param datasetSize cardinalidad del conjunto de datos.
+  \param confAtts número de atributos sensibles.
+*/
+void checkSweepSetting(const SweepSetting &setting, const int datasetSize,
+                       const int confAtts) {
+  if (setting.K == -1 && setting.L == -1 && setting.T == -1)
+    throw "Error, some privacy technique should be used.";
+  if (setting.K > datasetSize || setting.L > datasetSize)
+    throw "Error: K and L values should be equal or less than dataset size.";
+  if ((setting.L != -1 || setting.T != -1) && confAtts == 0)
+    throw "An error occured.\nIf l-diversity or t-closeness "
+          "are used, there should exists, at least, one "
+          "confidential attribute.";
+}
+
+/*! Calcula el tiempo transcurrido desde un instante dado.
+  \param start instante inicial.
+  \return segundos transcurridos.
+*/
+double elapsedSeconds(const chrono::steady_clock::time_point &start) {
+  return chrono::duration<double>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+/*! Calcula el número de hilos a utilizar.
+  \param threads número de hilos solicitado (0 para utilizar todos los
+                 núcleos disponibles).
+  \return número de hilos.
+*/
+size_t poolThreads(int threads) {
+  if (threads > 0)
+    return threads;
+  return max(1u, thread::hardware_concurrency());
+}
+
+/*! Calcula el nombre del fichero de métricas del barrido. Por defecto se
+    escribe junto a los conjuntos de datos anonimizados.
+  \param config configuración del barrido.
+  \param inputFname directorio del conjunto de datos.
+  \param algorithm nombre del algoritmo.
+  \return ruta del fichero.
+*/
+string sweepOutputName(const SweepConfig &config, const string &inputFname,
+                       const string &algorithm) {
+  if (!config.output.empty())
+    return config.output;
+  return anonymizedTableName(inputFname, -1, -1, -1, "sweep_" + algorithm);
+}
+
+/*! Escribe la cabecera del fichero de métricas.
+  \param fp stream que referencia el fichero de métricas.
+*/
+void writeSweepHeader(ofstream &fp) {
+  fp << "algorithm;K;L;T;clusters;load_s;run_s;metrics_s;GCP;DM;CAvg;GenILoss"
+     << endl;
+}
+
+/*! Escribe una fila del fichero de métricas. Las métricas no calculadas
+    se dejan vacías.
+  \param fp stream que referencia el fichero de métricas.
+  \param algorithm nombre del algoritmo.
+  \param loadSeconds tiempo de lectura de los datos, compartido por todas las
+                     ejecuciones.
+  \param result resultado de la ejecución.
+*/
+void writeSweepRow(ofstream &fp, const string &algorithm,
+                   const double loadSeconds, const SweepResult &result) {
+  auto metric = [](const long double value) {
+    if (value == -1)
+      return string();
+    stringstream stream;
+    stream << fixed << setprecision(6) << value;
+    return stream.str();
+  };
+
+  fp << algorithm << ";" << result.setting.K << ";" << result.setting.L << ";"
+     << (result.setting.T == -1 ? "-1" : metric(result.setting.T)) << ";"
+     << result.clusters << ";" << fixed << setprecision(6) << loadSeconds
+     << ";" << result.runSeconds << ";" << result.metricsSeconds << ";"
+     << metric(result.gcp) << ";" << metric(result.dm) << ";"
+     << metric(result.cavg) << ";" << metric(result.genILoss) << endl;
+}
@@ -0,0 +1,76 @@
+/*! \file sweep.h
+    \brief Fichero de cabecera del archivo sweep.cpp.
+*/
+
+#ifndef _SWEEP_H
+#define _SWEEP_H
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+
+/*! Estructura SweepSetting. Valores de los parámetros de los modelos de
+    privacidad utilizados en una ejecución (-1 si no se utiliza el modelo).
+*/
+struct SweepSetting {
+  int K = -1;
+  int L = -1;
+  long double T = -1;
+};
+
+/*! Estructura SweepConfig. Parámetros de un barrido en modo batch, leídos
+    de un fichero de configuración en lugar de la entrada estándar.
+*/
+struct SweepConfig {
+  vector<string> qidNames;
+  vector<string> confAttNames;
+  vector<string> numericNames;
+  vector<string> orderedNames;
+  vector<double> weights;
+  long double suppThreshold = -1;
+  string output;
+  int threads = 0;
+  int processes = 0;
+  int memory = 0;
+  string spill;
+  vector<SweepSetting> settings;
+};
+
+/*! Estructura SweepResult. Resultado y métricas de una ejecución del
+    barrido (-1 en las métricas no calculadas).
+*/
+struct SweepResult {
+  SweepSetting setting;
+  size_t clusters = 0;
+  double runSeconds = 0;
+  double metricsSeconds = 0;
+  long double gcp = -1;
+  long double dm = -1;
+  long double cavg = -1;
+  long double genILoss = -1;
+};
+
+bool isBatchMode(int argc, char **argv);
+SweepConfig readSweepConfig(const string &fname);
+vector<double> sweepWeights(const SweepConfig &config);
+tuple<vector<int>, vector<int>>
+sweepMetricsQids(const SweepConfig &config, const vector<int> &numQids,
+                 const vector<int> &catQids, const vector<string> &headers);
+vector<int> sweepOrderedAtts(const SweepConfig &config,
+                             const vector<int> &confAtts,
+                             const vector<string> &headers);
+void checkSweepSetting(const SweepSetting &setting, const int datasetSize,
+                       const int confAtts);
+double elapsedSeconds(const chrono::steady_clock::time_point &start);
+size_t poolThreads(int threads);
+string sweepOutputName(const SweepConfig &config, const string &inputFname,
+                       const string &algorithm);
+void writeSweepHeader(ofstream &fp);
+void writeSweepRow(ofstream &fp, const string &algorithm,
+                   const double loadSeconds, const SweepResult &result);
+
+#endif
@@ -0,0 +1,194 @@
+/*! \file tCloseness.cpp
+    \brief Fichero que contiene la clase TClosenessEvaluator, que comprueba
+           el modelo de privacidad t-closeness a partir de la distribución
+           global de cada atributo sensible, calculada una única vez.
+*/
+
+#include "tCloseness.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+
+/*! Constructor por defecto de la clase TClosenessEvaluator (sin atributos
+    sensibles).
+  \return instancia del evaluador.
+*/
+TClosenessEvaluator::TClosenessEvaluator() {}
+
+/*! Constructor de la clase TClosenessEvaluator.
+  \param dataset conjunto de datos.
+  \param confAtts índices de los atributos sensibles.
+  \param orderedAtts índices de los atributos sensibles numéricos, que
+                     utilizan la distancia ordenada.
+  \return instancia del evaluador.
+*/
+TClosenessEvaluator::TClosenessEvaluator(const vector<vector<string>> &dataset,
+                                         const vector<int> &confAtts,
+                                         const vector<int> &orderedAtts) {
+  for (const int &att : confAtts) {
+    const bool isOrdered =
+        find(orderedAtts.begin(), orderedAtts.end(), att) != orderedAtts.end();
+
+    map<string, int> frequencies;
+    for (const auto &record : dataset)
+      frequencies[record[att]]++;
+    addAttribute(frequencies, isOrdered);
+
+    // Códigos de cada registro
+    const map<string, int> &index = this->index.back();
+    vector<int> column;
+    column.reserve(dataset.size());
+    for (const auto &record : dataset)
+      column.emplace_back(index.at(record[att]));
+    this->codes.emplace_back(column);
+  }
+}
+
+/*! Constructor de la clase TClosenessEvaluator a partir de la frecuencia de
+    cada valor de los atributos sensibles. No codifica ningún registro.
+  \param frequencies frecuencia de cada valor, por atributo sensible.
+  \param ordered indica si cada atributo sensible utiliza la distancia
+                 ordenada.
+  \return instancia del evaluador.
+*/
+TClosenessEvaluator::TClosenessEvaluator(
+    const vector<map<string, int>> &frequencies, const vector<bool> &ordered) {
+  for (size_t att = 0; att < frequencies.size(); att++) {
+    addAttribute(frequencies[att], ordered[att]);
+    this->codes.emplace_back();
+  }
+}
+
+/*! Asigna un código a cada valor de un atributo sensible y calcula su
+    distribución global.
+  \param frequencies frecuencia de cada valor del atributo.
+  \param isOrdered indica si el atributo utiliza la distancia ordenada.
+*/
+void TClosenessEvaluator::addAttribute(const map<string, int> &frequencies,
+                                       const bool isOrdered) {
+  // Valores distintos del atributo, en orden lexicográfico
+  vector<const string *> values;
+  for (const auto &entry : frequencies)
+    values.emplace_back(&entry.first);
+  if (isOrdered) {
+    vector<pair<long double, const string *>> numbers;
+    try {
+      for (const string *value : values)
+        numbers.emplace_back(stold(*value), value);
+    } catch (const logic_error &) {
+      throw "Error: Ordered confidential attributes should be numeric";
+    }
+    stable_sort(numbers.begin(), numbers.end(),
+                [](const pair<long double, const string *> &a,
+                   const pair<long double, const string *> &b) {
+                  return a.first < b.first;
+                });
+    for (size_t i = 0; i < numbers.size(); i++)
+      values[i] = numbers[i].second;
+  }
+
+  // Código de cada valor y distribución global
+  map<string, int> index;
+  long double total = 0;
+  for (size_t i = 0; i < values.size(); i++) {
+    index[*values[i]] = i;
+    total += frequencies.at(*values[i]);
+  }
+
+  vector<long double> distribution;
+  for (const string *value : values)
+    distribution.emplace_back((long double)frequencies.at(*value) / total);
+
+  this->index.emplace_back(index);
+  this->distributions.emplace_back(distribution);
+  this->ordered.emplace_back(isOrdered);
+}
+
+/*! Devuelve el número de atributos sensibles.
+  \return número de atributos.
+*/
+size_t TClosenessEvaluator::size() const { return this->codes.size(); }
+
+/*! Devuelve el número de valores distintos de un atributo sensible.
+  \param att posición del atributo en la lista de atributos sensibles.
+  \return número de valores.
+*/
+int TClosenessEvaluator::domain(size_t att) const {
+  return this->distributions[att].size();
+}
+
+/*! Devuelve el código del valor de un atributo sensible en cada registro.
+  \param att posición del atributo en la lista de atributos sensibles.
+  \return códigos, indexados por registro.
+*/
+const vector<int> &TClosenessEvaluator::getCodes(size_t att) const {
+  return this->codes[att];
+}
+
+/*! Devuelve el código de un valor de un atributo sensible.
+  \param att posición del atributo en la lista de atributos sensibles.
+  \param value valor del atributo.
+  \return código del valor.
+*/
+int TClosenessEvaluator::encode(size_t att, const string &value) const {
+  auto it = this->index[att].find(value);
+  if (it == this->index[att].end())
+    throw "Error: Unknown confidential attribute value";
+  return it->second;
+}
+
+/*! Devuelve un evaluador con la misma distribución global (Q) pero con los
+    códigos de otros registros, por ejemplo los de una parte del conjunto de
+    datos cargada en memoria.
+  \param codes códigos de cada atributo sensible, indexados por registro.
+  \return instancia del evaluador.
+*/
+TClosenessEvaluator
+TClosenessEvaluator::withCodes(vector<vector<int>> codes) const {
+  TClosenessEvaluator evaluator = *this;
+  evaluator.codes = move(codes);
+  return evaluator;
+}
+
+/*! Calcula la distancia EMD entre la distribución de una clase de
+    equivalencia (P) y la distribución global (Q) de un atributo sensible.
+  \param att posición del atributo en la lista de atributos sensibles.
+  \param histogram frecuencia de cada código en la clase.
+  \param classSize número de registros de la clase.
+  \return distancia EMD.
+*/
+long double TClosenessEvaluator::emd(size_t att, const vector<int> &histogram,
+                                     const int classSize) const {
+  const vector<long double> &distribution = this->distributions[att];
+  long double emd = 0;
+
+  if (this->ordered[att]) {
+    // Distancia ordenada: ED(P, Q) = sum(abs(sum(pj - qj))) / (m - 1)
+    if (distribution.size() < 2)
+      return 0;
+
+    long double cumulative = 0;
+    for (size_t i = 0; i < distribution.size(); i++) {
+      cumulative += (long double)histogram[i] / classSize - distribution[i];
+      emd += abs(cumulative);
+    }
+    return emd / (distribution.size() - 1);
+  }
+
+  for (size_t i = 0; i < distribution.size(); i++) {
+    if (histogram[i] > 0) {
+      // Entrada presente en P
+      // ED(Pi, Qi) = abs(Pi/Pi probability in P -
+      //					 Qi/Qi probability in Q)
+      emd += abs((long double)histogram[i] / classSize - distribution[i]);
+    } else {
+      // Entrada no presente en P
+      // ED(Pi, Qi) = abs(0 - Qi/Qi probability in Q)
+      emd += distribution[i];
+    }
+  }
+
+  // ED(P, Q) =  sum(sum(pj - qj)) / 2
+  return emd / 2;
+}
@@ -0,0 +1,49 @@
+/*! \file tCloseness.h
+    \brief Fichero de cabecera del archivo tCloseness.cpp.
+*/
+
+#ifndef _TCLOSENESS_H
+#define _TCLOSENESS_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*! Clase TClosenessEvaluator. Codifica los valores de cada atributo
+    sensible como enteros densos y calcula una única vez la distribución
+    global (Q) de cada uno de ellos. A partir del histograma de una clase
+    de equivalencia (P) calcula la distancia EMD entre ambas distribuciones,
+    utilizando la distancia de igualdad (atributos categóricos) o la
+    distancia ordenada (atributos numéricos). Los códigos siguen el orden
+    lexicográfico de los valores, o su orden numérico si la distancia es
+    ordenada. También puede construirse a partir de la frecuencia de cada
+    valor, sin codificar ningún registro.
+*/
+class TClosenessEvaluator {
+private:
+  vector<vector<int>> codes;
+  vector<map<string, int>> index;
+  vector<vector<long double>> distributions;
+  vector<bool> ordered;
+
+  void addAttribute(const map<string, int> &frequencies, const bool isOrdered);
+
+public:
+  TClosenessEvaluator();
+  TClosenessEvaluator(const vector<vector<string>> &dataset,
+                      const vector<int> &confAtts,
+                      const vector<int> &orderedAtts);
+  TClosenessEvaluator(const vector<map<string, int>> &frequencies,
+                      const vector<bool> &ordered);
+  size_t size() const;
+  int domain(size_t att) const;
+  int encode(size_t att, const string &value) const;
+  const vector<int> &getCodes(size_t att) const;
+  TClosenessEvaluator withCodes(vector<vector<int>> codes) const;
+  long double emd(size_t att, const vector<int> &histogram,
+                  const int classSize) const;
+};
+
+#endif
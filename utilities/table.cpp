@@ -0,0 +1,249 @@
+/*! \file table.cpp
+    \brief Fichero que contiene las clases Column y Table, responsables de
+           almacenar un conjunto de datos codificado mediante diccionarios.
+*/
+
+#include "table.h"
+
+//! Constructor vacio
+Column::Column(){};
+
+/*! Constructor a partir de un diccionario y de una lista de códigos ya
+    calculados (por ejemplo, por el lector de ficheros csv).
+  \param dictionary valores únicos de la columna, indexados por su código.
+  \param codes código de cada una de las celdas de la columna.
+*/
+Column::Column(vector<string> dictionary, vector<uint32_t> codes) {
+  this->dictionary = move(dictionary);
+  this->codes = move(codes);
+  this->index.reserve(this->dictionary.size());
+  for (size_t i = 0; i < this->dictionary.size(); i++)
+    this->index.emplace(this->dictionary[i], i);
+}
+
+/*! Devuelve el código de un valor, añadiéndolo al diccionario si no se
+    encuentra presente.
+  \param value valor a codificar.
+  \return código del valor.
+*/
+uint32_t Column::encode(const string &value) {
+  auto it = this->index.find(value);
+  if (it != this->index.end())
+    return it->second;
+
+  const uint32_t code = this->dictionary.size();
+  this->dictionary.emplace_back(value);
+  this->index.emplace(value, code);
+  return code;
+}
+
+/*! Añade una celda al final de la columna.
+  \param value valor de la celda.
+*/
+void Column::append(const string &value) {
+  this->codes.emplace_back(encode(value));
+}
+
+/*! Añade una celda ya codificada al final de la columna.
+  \param code código de la celda.
+*/
+void Column::appendCode(const uint32_t code) {
+  this->codes.emplace_back(code);
+}
+
+/*! Busca el código de un valor sin modificar el diccionario.
+  \param value valor a buscar.
+  \return código del valor, o -1 si no se encuentra presente.
+*/
+long Column::find(const string &value) const {
+  auto it = this->index.find(value);
+  if (it == this->index.end())
+    return -1;
+  return it->second;
+}
+
+/*! Devuelve el valor asociado a un código.
+  \param code código del valor.
+  \return valor decodificado.
+*/
+const string &Column::decode(const uint32_t code) const {
+  return this->dictionary[code];
+}
+
+/*! Devuelve el código de una celda.
+  \param row índice del registro.
+  \return código de la celda.
+*/
+uint32_t Column::at(const size_t row) const { return this->codes[row]; }
+
+/*! Devuelve el número de celdas de la columna.
+  \return número de celdas.
+*/
+size_t Column::size() const { return this->codes.size(); }
+
+/*! Devuelve el número de valores distintos del diccionario.
+  \return tamaño del diccionario.
+*/
+size_t Column::cardinality() const { return this->dictionary.size(); }
+
+/*! Devuelve los códigos de todas las celdas de la columna.
+  \return lista de códigos.
+*/
+const vector<uint32_t> &Column::getCodes() const { return this->codes; }
+
+/*! Devuelve el diccionario de la columna.
+  \return lista de valores indexada por código.
+*/
+const vector<string> &Column::getDictionary() const {
+  return this->dictionary;
+}
+
+/*! Sustituye el diccionario de la columna, traduciendo cada código antiguo
+    a su nuevo código. Permite generalizar una columna completa modificando
+    únicamente sus valores distintos.
+  \param mapping nuevo código de cada código antiguo.
+  \param newDictionary nuevo diccionario.
+*/
+void Column::recode(const vector<uint32_t> &mapping,
+                    const vector<string> &newDictionary) {
+  for (uint32_t &code : this->codes)
+    code = mapping[code];
+
+  this->dictionary = newDictionary;
+  this->index.clear();
+  this->index.reserve(this->dictionary.size());
+  for (size_t i = 0; i < this->dictionary.size(); i++)
+    this->index.emplace(this->dictionary[i], i);
+}
+
+/*! Elimina las celdas de los registros no marcados.
+  \param keep indica, para cada registro, si debe conservarse.
+*/
+void Column::keepRows(const vector<bool> &keep) {
+  size_t n = 0;
+  for (size_t i = 0; i < this->codes.size(); i++) {
+    if (keep[i])
+      this->codes[n++] = this->codes[i];
+  }
+  this->codes.resize(n);
+}
+
+//! Constructor vacio
+Table::Table(){};
+
+/*! Constructor.
+  \param headers cabecera del fichero. Define los nombres de los atributos
+                 presentes.
+*/
+Table::Table(vector<string> headers) {
+  this->headers = move(headers);
+  this->columns = vector<Column>(this->headers.size());
+}
+
+/*! Constructor a partir de columnas ya codificadas.
+  \param headers cabecera del fichero.
+  \param columns columnas codificadas, todas ellas de igual longitud.
+*/
+Table::Table(vector<string> headers, vector<Column> columns) {
+  this->headers = move(headers);
+  this->columns = move(columns);
+  this->rows = this->columns.empty() ? 0 : this->columns[0].size();
+}
+
+/*! Añade un registro a la tabla. Los registros incompletos se completan
+    con valores vacíos.
+  \param row registro.
+*/
+void Table::addRow(const vector<string> &row) {
+  // Registro con más atributos que la cabecera
+  while (this->columns.size() < row.size()) {
+    Column column;
+    for (size_t i = 0; i < this->rows; i++)
+      column.append("");
+    this->columns.emplace_back(column);
+  }
+
+  for (size_t j = 0; j < this->columns.size(); j++)
+    this->columns[j].append(j < row.size() ? row[j] : "");
+  this->rows++;
+}
+
+/*! Devuelve el número de registros de la tabla.
+  \return número de registros.
+*/
+size_t Table::numRows() const { return this->rows; }
+
+/*! Devuelve el número de atributos de la tabla.
+  \return número de columnas.
+*/
+size_t Table::numColumns() const { return this->columns.size(); }
+
+/*! Devuelve la cabecera de la tabla.
+  \return nombres de los atributos.
+*/
+const vector<string> &Table::getHeaders() const { return this->headers; }
+
+/*! Devuelve una columna de la tabla.
+  \param col índice del atributo.
+  \return columna.
+*/
+const Column &Table::getColumn(const int col) const {
+  return this->columns[col];
+}
+
+/*! Devuelve una columna modificable de la tabla.
+  \param col índice del atributo.
+  \return columna.
+*/
+Column &Table::getColumn(const int col) { return this->columns[col]; }
+
+/*! Devuelve el código de una celda.
+  \param row índice del registro.
+  \param col índice del atributo.
+  \return código de la celda.
+*/
+uint32_t Table::code(const size_t row, const int col) const {
+  return this->columns[col].at(row);
+}
+
+/*! Devuelve el valor decodificado de una celda.
+  \param row índice del registro.
+  \param col índice del atributo.
+  \return valor de la celda.
+*/
+const string &Table::value(const size_t row, const int col) const {
+  const Column &column = this->columns[col];
+  return column.decode(column.at(row));
+}
+
+/*! Decodifica un registro.
+  \param row índice del registro.
+  \return registro como lista de cadenas de caracteres.
+*/
+vector<string> Table::decodeRow(const size_t row) const {
+  vector<string> record;
+  record.reserve(this->columns.size());
+  for (const Column &column : this->columns)
+    record.emplace_back(column.decode(column.at(row)));
+  return record;
+}
+
+/*! Decodifica la tabla completa.
+  \return conjunto de datos en forma de matriz de dimensión 2.
+*/
+vector<vector<string>> Table::decode() const {
+  vector<vector<string>> dataset;
+  dataset.reserve(this->rows);
+  for (size_t i = 0; i < this->rows; i++)
+    dataset.emplace_back(decodeRow(i));
+  return dataset;
+}
+
+/*! Elimina los registros no marcados de todas las columnas.
+  \param keep indica, para cada registro, si debe conservarse.
+*/
+void Table::keepRows(const vector<bool> &keep) {
+  for (Column &column : this->columns)
+    column.keepRows(keep);
+  this->rows = this->columns.empty() ? 0 : this->columns[0].size();
+}
@@ -0,0 +1,68 @@
+/*! \file table.h
+    \brief Fichero de cabecera del archivo table.cpp.
+*/
+
+#ifndef _TABLE_H
+#define _TABLE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/*! Clase Column. Almacena los valores de un atributo codificados como
+    enteros densos, junto al diccionario que permite decodificarlos.
+*/
+class Column {
+private:
+  vector<string> dictionary;
+  unordered_map<string, uint32_t> index;
+  vector<uint32_t> codes;
+
+public:
+  Column();
+  Column(vector<string> dictionary, vector<uint32_t> codes);
+  uint32_t encode(const string &value);
+  void append(const string &value);
+  void appendCode(const uint32_t code);
+  long find(const string &value) const;
+  const string &decode(const uint32_t code) const;
+  uint32_t at(const size_t row) const;
+  size_t size() const;
+  size_t cardinality() const;
+  const vector<uint32_t> &getCodes() const;
+  const vector<string> &getDictionary() const;
+  void recode(const vector<uint32_t> &mapping,
+              const vector<string> &newDictionary);
+  void keepRows(const vector<bool> &keep);
+};
+
+/*! Clase Table. Representa un conjunto de datos por columnas (column-major),
+    donde cada celda es un código entero de su diccionario de columna.
+*/
+class Table {
+private:
+  vector<string> headers;
+  vector<Column> columns;
+  size_t rows = 0;
+
+public:
+  Table();
+  Table(vector<string> headers);
+  Table(vector<string> headers, vector<Column> columns);
+  void addRow(const vector<string> &row);
+  size_t numRows() const;
+  size_t numColumns() const;
+  const vector<string> &getHeaders() const;
+  const Column &getColumn(const int col) const;
+  Column &getColumn(const int col);
+  uint32_t code(const size_t row, const int col) const;
+  const string &value(const size_t row, const int col) const;
+  vector<string> decodeRow(const size_t row) const;
+  vector<vector<string>> decode() const;
+  void keepRows(const vector<bool> &keep);
+};
+
+#endif
@@ -7,97 +7,65 @@
 #include <iostream>
 
 //! Constructor vacio
-Tree::Tree(){};
+Tree::Tree() { this->index = make_shared<const HierarchyIndex>(); };
 
 /*! Constructor.
   \param hierarchy jeraquía a mostrar en formato de árbol.
 */
-Tree::Tree(vector<vector<string>> hierarchy) {
+Tree::Tree(const vector<vector<string>> &hierarchy) {
+  this->index = make_shared<const HierarchyIndex>(hierarchy);
 
-  for (const auto &entries : hierarchy) {
-    addLeave(entries[0], entries[1], entries.size() - 1);
-
-    size_t i;
-    string child = entries[0];
-    for (i = 1; i < entries.size() - 1; i++) {
-      child = addNode(entries[i], child, entries[i + 1].c_str());
-    }
-
-    addNode(entries[i], child);
-  }
-
-  // Calculate tree height
-  this->height = calculateHeight();
+  const int rootId = this->index->getRoot();
+  if (rootId != -1)
+    this->root = this->index->value(rootId);
 }
 
-/*! Añade un nodo hoja al árbol.
-  \param value valor del nodo hoja.
-  \param parent valor del nodo padre.
-  \param depth profundidad en la que se encuentra la hoja.
+/*! Devuelve la representación compacta de la jerarquía.
+  \return jerarquía indexada por enteros.
 */
-void Tree::addLeave(string value, string parent, int depth) {
-  // Check if leave is already present
-  if (this->nodes.count(value))
-    return;
+const HierarchyIndex &Tree::getIndex() const { return *this->index; }
 
-  Node node;
-  node.value = value;
-  node.parent = parent;
-  node.isLeaf = true;
-  node.depth = depth;
-  this->nodes[value] = node;
-
-  this->leaves.emplace_back(value);
-}
-
-/*! Añade un nodo al árbol.
+/*! Devuelve el identificador de un nodo.
   \param value valor del nodo.
-  \param child valor del nodo hijo.
-  \param parent valor del nodo padre.
+  \return identificador del nodo, o -1 si no se encuentra presente.
 */
-string Tree::addNode(string value, string child, const char *parent) {
+int Tree::getId(const string &value) const { return this->index->find(value); }
 
-  // Node already present
-  if (this->nodes.count(value)) {
-    this->nodes[value].children.insert(child);
-    this->nodes[value].numSubTreeLeaves += 1;
-    return value;
-  }
-
-  // Node not present
+/*! Construye el nodo correspondiente a un identificador.
+  \param id identificador del nodo.
+  \return nodo (vacío si el identificador es -1).
+*/
+Node Tree::getNode(int id) const {
   Node node;
-  node.value = value;
-  if (parent)
-    node.parent = (string)parent;
-  else {
-    node.parent = value;
-    this->root = value;
-  }
-
-  node.depth = this->nodes[child].depth - 1;
-  node.children = {child};
-  node.numSubTreeLeaves += 1;
-  this->nodes[value] = node;
+  if (id == -1)
+    return node;
 
-  return value;
+  node.value = this->index->value(id);
+  node.parent = this->index->value(this->index->parent(id));
+  node.isLeaf = this->index->isLeaf(id);
+  node.depth = this->index->depth(id);
+  node.numSubTreeLeaves = this->index->numSubTreeLeaves(id);
+  for (const int child : this->index->children(id))
+    node.children.insert(this->index->value(child));
+  return node;
 }
 
-/*! Calcula la altura del árbol.
-  \return altura del árbol.
+/*! Traduce una lista de identificadores a sus valores.
+  \param ids identificadores de los nodos.
+  \return valores de los nodos.
 */
-int Tree::calculateHeight() {
-  set<int> depths;
-
-  for (const string &value : leaves)
-    depths.insert(this->nodes[value].depth);
-
-  return *max_element(depths.begin(), depths.end()) + 1;
+vector<string> Tree::getValues(const vector<int> &ids) const {
+  vector<string> values;
+  values.reserve(ids.size());
+  for (const int id : ids)
+    values.emplace_back(this->index->value(id));
+  return values;
 }
 
 /*! Devuelve la altura del árbol.
   \return altura del árbol.
 */
-int Tree::getHeight() { return this->height; }
+int Tree::getHeight() const { return this->index->getHeight(); }
 
 /*! Devuelve la altura del árbol dado un nodo y la profundidad máxima
     conocida del mismo.
@@ -105,17 +73,10 @@ int Tree::getHeight() { return this->height; }
   \param depth profundidad máxima conocida.
   \return altura del árbol.
 */
-int Tree::getHeight(string value, int &depth) {
-  const Node node = this->nodes[value];
-  int aux;
-
-  for (const auto &child : node.children) {
-    aux = getDepth(child);
-    if (aux > depth)
-      depth = aux;
-
-    getHeight(child, depth);
-  }
+int Tree::getHeight(const string &value, int &depth) const {
+  const int id = getId(value);
+  if (id != -1 && this->index->maxDescendantDepth(id) > depth)
+    depth = this->index->maxDescendantDepth(id);
 
   return depth;
 }
@@ -124,72 +85,79 @@ int Tree::getHeight(string value, int &depth) {
   \param value valor del nodo.
   \return altura del subárbol.
 */
-int Tree::getHeight(string value) {
-  const Node node = this->nodes[value];
-  int maxDepth = node.depth;
-
-  for (const auto &child : node.children)
-    getHeight(child, maxDepth);
-
-  return maxDepth - node.depth + 1;
+int Tree::getHeight(const string &value) const {
+  const int id = getId(value);
+  return id == -1 ? 1 : this->index->subTreeHeight(id);
 }
 
 /*! Devuelve el número de hojas descientes del nodo dado.
   \param value valor del nodo.
   \return número de hojas.
 */
-int Tree::getNumSubTreeLeaves(string value) {
-  return this->nodes[value].numSubTreeLeaves;
+int Tree::getNumSubTreeLeaves(const string &value) const {
+  const int id = getId(value);
+  return id == -1 ? 0 : this->index->numSubTreeLeaves(id);
 }
 
 /*! Devuelve la profundidad del subárbol del que el nodo dado es raiz.
   \param value valor del nodo.
   \return profundidad del subárbol.
 */
-int Tree::getDepth(string value) { return this->nodes[value].depth; }
+int Tree::getDepth(const string &value) const {
+  const int id = getId(value);
+  return id == -1 ? 0 : this->index->depth(id);
+}
 
 /*! Determina si un nodo es hijo de otro.
   \param node valor del nodo padre.
   \param target valor del posible nodo hijo.
   \return 1 si target es hijo de node, y 0 si no es así.
 */
-bool Tree::isChild(string node, string target) {
-  set<string> children = this->nodes[node].children;
+bool Tree::isChild(const string &node, const string &target) const {
+  const int nodeId = getId(node);
+  const int targetId = getId(target);
+  if (nodeId == -1 || targetId == -1)
+    return false;
 
-  if (find(children.begin(), children.end(), target) != children.end())
-    return true;
-
-  for (const auto &child : children) {
-    if (isChild(child, target))
-      return true;
-  }
-
-  return false;
+  return this->index->isDescendant(nodeId, targetId);
 }
 
 /*! Devuelve los hijos directos del nodo dado.
   \param value valor del nodo.
   \return nodos hijos.
 */
-vector<string> Tree::getDirectChildren(string value) {
-  set<string> children = this->nodes[value].children;
-  return vector<string>(children.begin(), children.end());
+vector<string> Tree::getDirectChildren(const string &value) const {
+  const int id = getId(value);
+  if (id == -1)
+    return {};
+  return getValues(this->index->children(id));
 }
 
-/*! Devuelve todos los hijos del nodo dado.
-  \param value valor del nodo.
-  \return nodos hijos.
+/*! Añade a la lista dada todos los hijos del nodo. Los descendientes de
+    cada hijo se colocan al principio de la lista.
+  \param id identificador del nodo.
+  \param children nodos hijos.
 */
-vector<string> Tree::getAllChildren(string value) {
-  vector<string> children;
-
-  for (const auto &child : this->nodes[value].children) {
+void Tree::getAllChildren(int id, vector<int> &children) const {
+  for (const int child : this->index->children(id)) {
     children.emplace_back(child);
-    vector<string> next = getAllChildren(child);
+    vector<int> next;
+    getAllChildren(child, next);
     children.insert(children.begin(), next.begin(), next.end());
   }
+}
+
+/*! Devuelve todos los hijos del nodo dado.
+  \param value valor del nodo.
+  \return nodos hijos.
+*/
+vector<string> Tree::getAllChildren(const string &value) const {
+  vector<int> children;
+  const int id = getId(value);
+  if (id != -1)
+    getAllChildren(id, children);
 
-  return children;
+  return getValues(children);
 }
 
 /*! Devuelve los nodos hijos del nodo dado que se encuentren
@@ -197,89 +165,65 @@ vector<string> Tree::getAllChildren(string value) {
   \param value valor del nodo.
   \return hijos del nodo.
 */
-vector<string> Tree::getChildrenInLevel(string value) {
-  vector<string> children;
-  const int level = this->nodes[value].depth + 1;
-
-  for (auto const &[k, v] : this->nodes) {
-    if (v.depth == level)
-      children.emplace_back(k);
-  }
-
-  return children;
+vector<string> Tree::getChildrenInLevel(const string &value) const {
+  return getValues(this->index->nodesInLevel(getDepth(value) + 1));
 }
 
 /*! Devuelve la siguiente generalización del valor dado.
   \param value valor del nodo.
   \return valor generalizado.
 */
-string Tree::getNextGen(string value) {
-
-  // Node present
-  if (this->nodes.count(value)) {
-    string parent = this->nodes[value].parent;
-    if (parent == value)
-      return value;
-
-    return parent;
-  }
+string Tree::getNextGen(const string &value) const {
+  const int id = getId(value);
 
   // Not found
-  throw "Error: Element not found in the tree";
+  if (id == -1)
+    throw "Error: Element not found in the tree";
+
+  return this->index->value(this->index->parent(id));
 }
 
 /*! Devuelve el número de hojas de las que se compone el árbol.
   \return número de hojas.
 */
-int Tree::getNumLeaves() { return this->leaves.size(); }
+int Tree::getNumLeaves() const { return this->index->numLeaves(); }
 
-/*! Devuelve el ancestro común de dos nodos.
-  \param node nodo de menor profundidad.
-  \param target nodo de mayor profundidad.
-  \return nodo ancestro.
+/*! Devuelve el ancestro común, posicionado a menor profundidad,
+    de varios nodos.
+  \param values valores de todos los nodos.
+  \return identificador del nodo ancestro, o -1 si no se encuentra.
 */
-Node Tree::getCommonAncestor(Node node, string target) {
-  if (node.value == target)
-    return this->nodes[node.value];
-
-  if (find(node.children.begin(), node.children.end(), target) !=
-      node.children.end())
-    return node;
-
-  Node n = this->nodes[node.parent];
-  vector<string> children = getAllChildren(node.value);
-
-  if (find(children.begin(), children.end(), target) == children.end())
-    return getCommonAncestor(n, target);
+int Tree::getLowestCommonAncestorId(const vector<string> &values) const {
+  if (values.empty())
+    return -1;
+  if (values.size() == 1)
+    return getId(values[0]);
+
+  vector<int> ids;
+  ids.reserve(values.size());
+  for (const string &value : values) {
+    const int id = getId(value);
+    if (id == -1)
+      throw "Error: Element not found in the tree";
+    ids.emplace_back(id);
+  }
 
-  return n;
+  return this->index->lowestCommonAncestor(ids);
 }
 
-/*! Devuelve el ancestro común, posicionado a menor profundidad, de dos nodos.
-  \param r1 valor del primer nodo.
-  \param r2 valor del segundo nodo.
-  \return nodo ancestro.
+/*! Devuelve el valor del ancestro común más profundo de dos nodos.
+  \param v1 valor del primer nodo.
+  \param v2 valor del segundo nodo.
+  \return valor del nodo ancestro.
 */
-Node Tree::getLowestCommonAncestor(string r1, string r2) {
-
-  Node n1 = this->nodes[r1];
-  Node n2 = this->nodes[r2];
-  Node node;
-  string target;
-
-  if (r1 == r2)
-    return this->nodes[r1];
-
-  if (this->nodes[n1.parent].numSubTreeLeaves <
-      this->nodes[n2.parent].numSubTreeLeaves) {
-    node = this->nodes[n1.parent];
-    target = n2.value;
-  } else {
-    node = this->nodes[n2.parent];
-    target = n1.value;
-  }
-
-  return getCommonAncestor(node, target);
+const string &Tree::getLowestCommonAncestor(const string &v1,
+                                            const string &v2) const {
+  const int id1 = getId(v1);
+  const int id2 = getId(v2);
+  if (id1 == -1 || id2 == -1)
+    throw "Error: Element not found in the tree";
+
+  return this->index->value(this->index->lowestCommonAncestor(id1, id2));
 }
 
 /*! Devuelve el ancestro común, posicionado a menor profundidad,
@@ -287,36 +231,35 @@ Node Tree::getLowestCommonAncestor(string r1, string r2) {
   \param values valores de todos los nodos.
   \return nodo ancestro.
 */
-Node Tree::getLowestCommonAncestor(vector<string> values) {
-  Node node;
-  string aux = values[0];
-
-  if (values.size() == 1) {
-    return this->nodes[aux];
-  }
-
-  for (size_t i = 1; i < values.size(); i++) {
-    node = getLowestCommonAncestor(aux, values[i]);
-    // Return root node if we've reached it
-    if (node.parent == node.value)
-      return node;
-    aux = node.value;
-  }
-
-  return node;
+Node Tree::getLowestCommonAncestor(const vector<string> &values) const {
+  return getNode(getLowestCommonAncestorId(values));
 }
 
 /*! Calcula el valor de la métrica NCP dado un conjunto de nodos.
   \param values valores de los nodos.
   \return valor de la métrica NCP.
 */
-long double Tree::getNCP(vector<string> values) {
+long double Tree::getNCP(const vector<string> &values) const {
   // Get unique values only
   vector<string> aux = values;
   vector<string>::iterator it = unique(aux.begin(), aux.end());
   aux.resize(distance(aux.begin(), it));
 
-  int subTreeLeaves = getLowestCommonAncestor(aux).numSubTreeLeaves;
+  const int ancestor = getLowestCommonAncestorId(aux);
+  int subTreeLeaves =
+      ancestor == -1 ? 0 : this->index->numSubTreeLeaves(ancestor);
   long double ncp = (long double)subTreeLeaves;
   return ncp;
 }
+
+/*! Busca el árbol jerárquico de un atributo sin copiarlo.
+  \param trees árboles jerárquicos, indexados por atributo.
+  \param att índice del atributo.
+  \return árbol jerárquico del atributo, o un árbol vacío si el atributo
+          no tiene jerarquía.
+*/
+const Tree &findTree(const map<int, Tree> &trees, const int att) {
+  static const Tree empty;
+  auto it = trees.find(att);
+  return it == trees.end() ? empty : it->second;
+}
@@ -5,8 +5,10 @@
 #ifndef _TREE_H
 #define _TREE_H
 
+#include "hierarchyIndex.h"
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -21,44 +23,46 @@ struct Node {
   string parent;
   set<string> children;
   string value;
-  int depth;
+  int depth = 0;
 };
 
 /*! Clase Tree. Su función es simular un árbol jerárquico correspondiente
-    a un atributo específico.
+    a un atributo específico. Actúa como fachada sobre la representación
+    compacta de la jerarquía (HierarchyIndex).
 */
 class Tree {
 private:
-  map<string, Node> nodes;
-  vector<string> leaves;
-  int height;
-  string addNode(string value, string child, const char *parent = NULL);
-  void addLeave(string value, string children, int depth);
-  int calculateHeight();
-  Node getCommonAncestor(Node node, string target);
-  Node getLowestCommonAncestor(string r1, string r2);
+  shared_ptr<const HierarchyIndex> index;
+  int getId(const string &value) const;
+  Node getNode(int id) const;
+  vector<string> getValues(const vector<int> &ids) const;
+  void getAllChildren(int id, vector<int> &children) const;
+  int getLowestCommonAncestorId(const vector<string> &values) const;
 
 public:
   string root;
   // Constructors
   Tree();
-  Tree(vector<vector<string>> hierarchy);
+  Tree(const vector<vector<string>> &hierarchy);
   // Methods
-  int getHeight();
-  int getHeight(string value);
-  int getHeight(string value, int &depth);
-  int getNumSubTreeLeaves(string value);
-  bool isChild(string node, string child);
-  vector<string> getDirectChildren(string value);
-  vector<string> getAllChildren(string value);
-  vector<string> getChildrenInLevel(string value);
-  Node *getDescendant(Node *node, string target);
-  int getParentDiff(string value1, string value2);
-  int getDepth(string value);
-  string getNextGen(string value);
-  int getNumLeaves();
-  Node getLowestCommonAncestor(vector<string> values);
-  long double getNCP(vector<string> values);
+  const HierarchyIndex &getIndex() const;
+  int getHeight() const;
+  int getHeight(const string &value) const;
+  int getHeight(const string &value, int &depth) const;
+  int getNumSubTreeLeaves(const string &value) const;
+  bool isChild(const string &node, const string &child) const;
+  vector<string> getDirectChildren(const string &value) const;
+  vector<string> getAllChildren(const string &value) const;
+  vector<string> getChildrenInLevel(const string &value) const;
+  int getDepth(const string &value) const;
+  string getNextGen(const string &value) const;
+  int getNumLeaves() const;
+  const string &getLowestCommonAncestor(const string &v1,
+                                        const string &v2) const;
+  Node getLowestCommonAncestor(const vector<string> &values) const;
+  long double getNCP(const vector<string> &values) const;
 };
 
+const Tree &findTree(const map<int, Tree> &trees, const int att);
+
 #endif
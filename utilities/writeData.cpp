@@ -7,6 +7,23 @@
 
 #define GET_NAME(Var) (#Var)
 
+/*! Escribe en el fichero apuntado por el stream fp un registro como
+    cadenas de caracteres.
+  \param fp stream que referencia el fichero en el realizar la escritura.
+  \param record registro.
+  \param delimiter delimitador a utilizar para separar los datos.
+*/
+void writeRecord(ofstream &fp, const vector<string> &record,
+                 const string &delimiter) {
+  string line;
+  for (const string &value : record) {
+    if (!line.empty())
+      line += delimiter;
+    line += value;
+  }
+  fp << line << '\n';
+}
+
 /*! Escribe en el fichero apuntado por el stream fp,
     el conjunto de datos dataset como cadenas de caracteres.
   \param fp stream que referencia el fichero en el realizar la escritura.
@@ -16,33 +33,22 @@
 void writeStrings(ofstream &fp, vector<vector<string>> dataset,
                   string delimiter) {
   // Write all records
-  for (size_t i = 0; i < dataset.size(); i++) {
-    fp << accumulate(
-              dataset[i].begin(), dataset[i].end(), string(),
-              [](string &a, string &b) { return a.empty() ? b : a + ";" + b; })
-       << endl;
-  }
+  for (size_t i = 0; i < dataset.size(); i++)
+    writeRecord(fp, dataset[i], ";");
 }
 
-/*! Escribe el conjunto de datos anonimizado en un fichero localizado
-    en un directorio concreto, delimitado por el valor de los parámetros
-    relacionados con los modelos de privacidad utilizados para anonimizar
-    los datos.
+/*! Calcula el nombre del fichero en el que escribir el conjunto de datos
+    anonimizado, creando el directorio que lo contiene si no existe.
   \param inputFname nombre inicial del fichero en el realizar la escritura.
-  \param headers cabecera del fichero. Define los nombres de los atributos presentes.
-  \param dataset conjunto de datos anonimizados.
   \param K parámetro del modelo de privacidad k-anonymity.
   \param L parámetro del modelo de privacidad l-diversity.
   \param T parámetro del modelo de privacidad t-closeness.
   \param exFileName nombre de fichero absoluto, sobre el que no se realizaran
                 modificaciones. (opcional).
-  \param verbose indica si se debe mostrar información por pantalla.
-
+  \return ruta del fichero.
 */
-void writeAnonymizedTable(const string inputFname, const vector<string> headers,
-                          const vector<vector<string>> dataset, const int K,
-                          const int L, const long double T, const string exFileName,
-                          const bool verbose) {
+string anonymizedTableName(const string inputFname, const int K, const int L,
+                           const long double T, const string exFileName) {
   string kName = K == -1 ? "" : to_string(K) + GET_NAME(K);
   if (L != -1 && K != -1)
     kName += "_";
@@ -69,7 +75,6 @@ void writeAnonymizedTable(const string inputFname, const vector<string> headers,
   if (!fs::is_directory(dname) || !fs::exists(dname)) {
     if (!fs::create_directories(dname)) {
       throw "Error creating output directory";
-      return;
     }
   }
 
@@ -79,6 +84,30 @@ void writeAnonymizedTable(const string inputFname, const vector<string> headers,
   else
     fname += exFileName + ".csv";
 
+  return fname;
+}
+
+/*! Escribe el conjunto de datos anonimizado en un fichero localizado
+    en un directorio concreto, delimitado por el valor de los parámetros
+    relacionados con los modelos de privacidad utilizados para anonimizar
+    los datos.
+  \param inputFname nombre inicial del fichero en el realizar la escritura.
+  \param headers cabecera del fichero. Define los nombres de los atributos presentes.
+  \param dataset conjunto de datos anonimizados.
+  \param K parámetro del modelo de privacidad k-anonymity.
+  \param L parámetro del modelo de privacidad l-diversity.
+  \param T parámetro del modelo de privacidad t-closeness.
+  \param exFileName nombre de fichero absoluto, sobre el que no se realizaran
+                modificaciones. (opcional).
+  \param verbose indica si se debe mostrar información por pantalla.
+
+*/
+void writeAnonymizedTable(const string inputFname, const vector<string> headers,
+                          const vector<vector<string>> dataset, const int K,
+                          const int L, const long double T, const string exFileName,
+                          const bool verbose) {
+  const string fname = anonymizedTableName(inputFname, K, L, T, exFileName);
+
   if (verbose) {
     cout << "===> Writing data to file: " << endl;
     cout << "\t* " + fname << endl;
@@ -97,3 +126,80 @@ void writeAnonymizedTable(const string inputFname, const vector<string> headers,
 
   fp.close();
 }
+
+/*! Escribe un conjunto de datos anonimizado y codificado, decodificando
+    cada registro en el momento de escribirlo.
+  \param inputFname nombre inicial del fichero en el realizar la escritura.
+  \param table conjunto de datos anonimizados y codificados.
+  \param K parámetro del modelo de privacidad k-anonymity.
+  \param L parámetro del modelo de privacidad l-diversity.
+  \param T parámetro del modelo de privacidad t-closeness.
+  \param exFileName nombre de fichero absoluto, sobre el que no se realizaran
+                modificaciones. (opcional).
+  \param verbose indica si se debe mostrar información por pantalla.
+*/
+void writeAnonymizedTable(const string inputFname, const Table &table,
+                          const int K, const int L, const long double T,
+                          const string exFileName, const bool verbose) {
+  const string fname = anonymizedTableName(inputFname, K, L, T, exFileName);
+
+  if (verbose) {
+    cout << "===> Writing data to file: " << endl;
+    cout << "\t* " + fname << endl;
+  }
+  ofstream fp(fname);
+
+  try {
+    writeStrings(fp, {table.getHeaders()}, ";");
+    for (size_t i = 0; i < table.numRows(); i++)
+      writeStrings(fp, {table.decodeRow(i)}, ";");
+  } catch (...) {
+    cout << "Error writing anonymized data to file" << endl;
+  }
+
+  fp.close();
+}
+
+/*! Constructor de la clase TableWriter. Abre el fichero en el que escribir
+    el conjunto de datos anonimizado y escribe su cabecera.
+  \param inputFname nombre inicial del fichero en el realizar la escritura.
+  \param headers cabecera del fichero. Define los nombres de los atributos
+                 presentes.
+  \param K parámetro del modelo de privacidad k-anonymity.
+  \param L parámetro del modelo de privacidad l-diversity.
+  \param T parámetro del modelo de privacidad t-closeness.
+  \param exFileName nombre de fichero absoluto, sobre el que no se realizaran
+                modificaciones. (opcional).
+  \param verbose indica si se debe mostrar información por pantalla al
+                 cerrar el fichero.
+  \return instancia del escritor.
+*/
+TableWriter::TableWriter(const string inputFname,
+                         const vector<string> &headers, const int K,
+                         const int L, const long double T,
+                         const string exFileName, const bool verbose) {
+  this->fname = anonymizedTableName(inputFname, K, L, T, exFileName);
+  this->verbose = verbose;
+  this->fp.open(this->fname);
+  writeRecord(this->fp, headers, ";");
+}
+
+/*! Escribe los registros de una clase de equivalencia.
+  \param records registros anonimizados.
+*/
+void TableWriter::write(const vector<vector<string>> &records) {
+  for (const auto &record : records)
+    writeRecord(this->fp, record, ";");
+}
+
+/*! Cierra el fichero, mostrando su nombre por pantalla si es necesario.
+*/
+void TableWriter::close() {
+  if (this->verbose) {
+    cout << "===> Writing data to file: " << endl;
+    cout << "\t* " + this->fname << endl;
+  }
+  this->fp.close();
+  if (this->fp.fail())
+    cout << "Error writing anonymized data to file" << endl;
+}
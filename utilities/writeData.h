@@ -5,6 +5,7 @@
 #ifndef _WRITEDATA_H
 #define _WRITEDATA_H
 
+#include "table.h"
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -14,11 +15,39 @@
 namespace fs = std::filesystem;
 using namespace std;
 
+/*! Clase TableWriter. Escribe un conjunto de datos anonimizado de forma
+    incremental: la cabecera se escribe al abrir el fichero y cada clase de
+    equivalencia en cuanto se añade, sin reunir antes el conjunto de datos
+    completo en memoria.
+*/
+class TableWriter {
+private:
+  ofstream fp;
+  string fname;
+  bool verbose;
+
+public:
+  // Constructor
+  TableWriter(const string inputFname, const vector<string> &headers,
+              const int K, const int L, const long double T,
+              const string exFileName = "", const bool verbose = true);
+  void write(const vector<vector<string>> &records);
+  void close();
+};
+
+void writeRecord(ofstream &fp, const vector<string> &record,
+                 const string &delimiter);
 void writeStrings(ofstream &fp, vector<vector<string>> dataset,
                   string delimiter);
+string anonymizedTableName(const string inputFname, const int K, const int L,
+                           const long double T, const string exFileName = "");
 void writeAnonymizedTable(const string inputFname, const vector<string> headers,
                           const vector<vector<string>> dataset, const int K,
                           const int L, const long double T,
                           const string exFileName = "", const bool verbose = true);
+void writeAnonymizedTable(const string inputFname, const Table &table,
+                          const int K, const int L, const long double T,
+                          const string exFileName = "",
+                          const bool verbose = true);
 
 #endif